@@ -0,0 +1,59 @@
+#ifndef BANKING_HPP
+#define BANKING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- Banked Multi-Issue Scheduler ---
+// Issues requests in order, up to issueWidth per cycle, into a cache split
+// into power-of-two many banks selected by the line address bits. A request
+// whose bank was already used in the current cycle stalls the issue stage
+// until the next cycle, as do all requests behind it.
+class BankScheduler {
+public:
+    size_t conflictStalls;
+
+    BankScheduler() : conflictStalls(0), issueWidth(1), bankMask(0), offsetBits(0),
+                      cycle(0), slotsUsed(0) {}
+
+    bool active() const { return issueWidth > 1 || bankMask > 0; }
+
+    void initialize(unsigned issueWidth, unsigned banks, uint32_t offsetBits) {
+        this->issueWidth = issueWidth ? issueWidth : 1;
+        this->offsetBits = offsetBits;
+        bankMask = banks ? banks - 1 : 0;
+        bankCycle.assign(bankMask + 1, 0);
+        cycle = 0;
+        slotsUsed = 0;
+        conflictStalls = 0;
+    }
+
+    // Schedules one request and returns the number of cycles it opened (0 or 1).
+    size_t issue(uint32_t addr) {
+        unsigned bank = (addr >> offsetBits) & bankMask;
+        size_t opened = 0;
+        if (cycle == 0 || slotsUsed == issueWidth) {
+            opened = 1;
+        } else if (bankCycle[bank] == cycle) {
+            conflictStalls++;
+            opened = 1;
+        }
+        if (opened) {
+            cycle++;
+            slotsUsed = 0;
+        }
+        bankCycle[bank] = cycle;
+        slotsUsed++;
+        return opened;
+    }
+
+private:
+    unsigned issueWidth, bankMask;
+    uint32_t offsetBits;
+    size_t cycle;
+    unsigned slotsUsed;
+    std::vector<size_t> bankCycle; // Last cycle each bank was busy
+};
+
+#endif
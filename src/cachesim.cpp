@@ -0,0 +1,158 @@
+#include "cachesim.h"
+#include "engine.hpp"
+#include <memory>
+#include <new>
+
+// Accesses between utility-based re-partitions when none is configured
+static const unsigned DEFAULT_REPARTITION_INTERVAL = 10000;
+
+// --- Library Handle ---
+struct cachesim {
+    std::unique_ptr<CacheModel> model;
+    std::vector<cachesim_result> tenantStats;
+};
+
+static bool isPowerOfTwo(unsigned n) {
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
+static cachesim_result difference(const cachesim_result& after, const cachesim_result& before) {
+    cachesim_result delta;
+    delta.cycles = after.cycles - before.cycles;
+    delta.misses = after.misses - before.misses;
+    delta.hits = after.hits - before.hits;
+    delta.primitiveGateCount = after.primitiveGateCount - before.primitiveGateCount;
+    delta.compulsoryMisses = after.compulsoryMisses - before.compulsoryMisses;
+    delta.capacityMisses = after.capacityMisses - before.capacityMisses;
+    delta.conflictMisses = after.conflictMisses - before.conflictMisses;
+    delta.requests = after.requests - before.requests;
+    delta.bankConflicts = after.bankConflicts - before.bankConflicts;
+    delta.tlbHits = after.tlbHits - before.tlbHits;
+    delta.tlbMisses = after.tlbMisses - before.tlbMisses;
+    return delta;
+}
+
+static void accumulate(cachesim_result& total, const cachesim_result& delta) {
+    total.cycles += delta.cycles;
+    total.misses += delta.misses;
+    total.hits += delta.hits;
+    total.primitiveGateCount += delta.primitiveGateCount;
+    total.compulsoryMisses += delta.compulsoryMisses;
+    total.capacityMisses += delta.capacityMisses;
+    total.conflictMisses += delta.conflictMisses;
+    total.requests += delta.requests;
+    total.bankConflicts += delta.bankConflicts;
+    total.tlbHits += delta.tlbHits;
+    total.tlbMisses += delta.tlbMisses;
+}
+
+static bool validPartitioning(const struct cachesim_config* config, unsigned tenants) {
+    switch (config->partitionPolicy) {
+        case CACHESIM_PARTITION_NONE:
+            return true;
+        case CACHESIM_PARTITION_STATIC: {
+            if (config->directMapped || !config->tenantWays) return false;
+            unsigned long total = 0;
+            for (unsigned t = 0; t < tenants; t++) {
+                if (config->tenantWays[t] == 0) return false;
+                total += config->tenantWays[t];
+            }
+            return total <= config->cacheLines;
+        }
+        case CACHESIM_PARTITION_UTILITY:
+            return !config->directMapped && tenants <= config->cacheLines;
+        default:
+            return false;
+    }
+}
+
+cachesim* cachesim_create(const struct cachesim_config* config) {
+    if (!config || !isPowerOfTwo(config->cacheLines) || !isPowerOfTwo(config->cacheLineSize)) {
+        return NULL;
+    }
+    unsigned tenants = config->numTenants ? config->numTenants : 1;
+    if (!validPartitioning(config, tenants)) return NULL;
+    if (config->numBanks && !isPowerOfTwo(config->numBanks)) return NULL;
+    if (config->tlbEntries && (!isPowerOfTwo(config->tlbEntries) || !isPowerOfTwo(config->pageSize) ||
+                               (config->tlbAssociativity && !isPowerOfTwo(config->tlbAssociativity)))) {
+        return NULL;
+    }
+    if (config->tlbAssociativity > config->tlbEntries) return NULL; // Also rejects ways without a TLB
+    if (config->regionSize && (!isPowerOfTwo(config->regionSize) || config->regionSize < 4096)) {
+        return NULL;
+    }
+
+    try {
+        std::unique_ptr<cachesim> sim(new cachesim);
+        if (config->directMapped) {
+            sim->model.reset(new DirectMappedModel);
+        } else {
+            sim->model.reset(new FullyAssociativeModel);
+        }
+        sim->model->configure(*config);
+        if (config->partitionPolicy != CACHESIM_PARTITION_NONE) {
+            unsigned interval = config->repartitionInterval ? config->repartitionInterval
+                                                            : DEFAULT_REPARTITION_INTERVAL;
+            static_cast<FullyAssociativeModel&>(*sim->model).enablePartitioning(
+                tenants, config->partitionPolicy, config->tenantWays, interval);
+        }
+        sim->tenantStats.assign(tenants, cachesim_result());
+        return sim.release();
+    } catch (const std::bad_alloc&) {
+        return NULL;
+    }
+}
+
+size_t cachesim_access_tenant_batch(cachesim* sim, unsigned tenant,
+                                    const struct cachesim_request requests[], size_t n,
+                                    struct cachesim_result* out) {
+    if (!sim || tenant >= sim->tenantStats.size() || (!requests && n > 0)) return 0;
+
+    cachesim_result before = sim->model->stats;
+    uint32_t data;
+    size_t i = 0;
+    PROFILE_PHASE_BEGIN(PROFILE_SIMULATION);
+    try {
+        for (; i < n; i++) {
+            sim->model->accessAs(tenant, requests[i], data);
+        }
+    } catch (const std::bad_alloc&) {
+        // Backing memory exhausted: report the requests completed so far
+    }
+    PROFILE_PHASE_END(PROFILE_SIMULATION, i);
+
+    cachesim_result delta = difference(sim->model->stats, before);
+    accumulate(sim->tenantStats[tenant], delta);
+    if (out) *out = delta;
+    return i;
+}
+
+size_t cachesim_access_batch(cachesim* sim, const struct cachesim_request requests[],
+                             size_t n, struct cachesim_result* out) {
+    return cachesim_access_tenant_batch(sim, 0, requests, n, out);
+}
+
+struct cachesim_result cachesim_stats(const cachesim* sim) {
+    if (!sim) {
+        cachesim_result empty = {};
+        return empty;
+    }
+    return sim->model->stats;
+}
+
+struct cachesim_result cachesim_tenant_stats(const cachesim* sim, unsigned tenant) {
+    if (!sim || tenant >= sim->tenantStats.size()) {
+        cachesim_result empty = {};
+        return empty;
+    }
+    return sim->tenantStats[tenant];
+}
+
+int cachesim_write_heatmap(const cachesim* sim, const char* path) {
+    if (!sim || !path || !sim->model->heatmap.active()) return -1;
+    return writeHeatmap(sim->model->heatmap, path);
+}
+
+void cachesim_destroy(cachesim* sim) {
+    delete sim;
+}
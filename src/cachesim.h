@@ -0,0 +1,111 @@
+#ifndef CACHESIM_H
+#define CACHESIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// --- Shared Data Types ---
+struct cachesim_request {
+    uint32_t addr;
+    uint32_t data;
+    int we; // Write Enable
+};
+
+struct cachesim_result {
+    size_t cycles;
+    size_t misses;
+    size_t hits;
+    size_t primitiveGateCount;
+
+    // 3C breakdown of misses; all zero unless classifyMisses is set
+    size_t compulsoryMisses;
+    size_t capacityMisses;
+    size_t conflictMisses;
+
+    // Issue statistics; cycles include bank stalls and page walks, so they
+    // equal requests only for a single-ported cache without a TLB
+    size_t requests;
+    size_t bankConflicts;    // Cycles lost to bank conflicts in multi-issue mode
+
+    // Address translation; all zero unless a TLB is configured
+    size_t tlbHits;
+    size_t tlbMisses;
+};
+
+enum cachesim_partition {
+    CACHESIM_PARTITION_NONE,    // Tenants share all lines under global LRU
+    CACHESIM_PARTITION_STATIC,  // Fixed line quota per tenant (CAT-style)
+    CACHESIM_PARTITION_UTILITY  // Quotas recomputed from utility monitors (UCP)
+};
+
+struct cachesim_config {
+    int directMapped;
+    unsigned cacheLines;     // Must be power of 2
+    unsigned cacheLineSize;  // Must be power of 2
+    unsigned cacheLatency;
+    unsigned memoryLatency;
+    int classifyMisses;      // Enables the compulsory/capacity/conflict breakdown
+
+    // Shared cache options; zero-initialized means a single tenant
+    unsigned numTenants;
+    int partitionPolicy;          // enum cachesim_partition, fully associative only
+    const unsigned* tenantWays;   // STATIC: lines reserved per tenant (numTenants entries)
+    unsigned repartitionInterval; // UTILITY: accesses between re-partitions
+    int sharedAddressSpace;       // Tenants address one memory (threads of one process);
+                                  // by default each tenant has a private address space
+
+    // Multi-issue timing; zero-initialized means one request per cycle, one bank
+    unsigned issueWidth;          // Requests issued per cycle
+    unsigned numBanks;            // Must be power of 2; bank = line address % numBanks
+
+    // TLB in front of the cache; zero tlbEntries disables translation
+    unsigned tlbEntries;          // Must be power of 2
+    unsigned tlbAssociativity;    // Power of 2, at most tlbEntries; 0 = fully associative
+    unsigned pageSize;            // Bytes, power of 2 (e.g. 4 KiB, 2 MiB, 1 GiB)
+    unsigned pageWalkLatency;     // Cycles added per TLB miss
+
+    // Heatmap profiler; zero regionSize disables it
+    unsigned regionSize;          // Region bucket in bytes, power of 2, at least 4096
+    unsigned heatmapTopN;         // Entries per thrashing list (0 = 10)
+};
+
+// --- Library Interface ---
+// Opaque handle to a kernel-free simulator instance. Any number of instances
+// may be created and destroyed within one process.
+typedef struct cachesim cachesim;
+
+// Returns NULL if the configuration is invalid or allocation fails.
+cachesim* cachesim_create(const struct cachesim_config* config);
+
+// Feeds n requests in order. If out is non-NULL it receives the counters
+// accumulated by this batch only. Returns the number of requests processed.
+size_t cachesim_access_batch(cachesim* sim, const struct cachesim_request requests[],
+                             size_t n, struct cachesim_result* out);
+
+// Same as cachesim_access_batch, issuing all requests on behalf of one tenant
+// of a shared cache (tenant < numTenants).
+size_t cachesim_access_tenant_batch(cachesim* sim, unsigned tenant,
+                                    const struct cachesim_request requests[], size_t n,
+                                    struct cachesim_result* out);
+
+// Cumulative counters since creation.
+struct cachesim_result cachesim_stats(const cachesim* sim);
+
+// Cumulative counters of a single tenant (hits and misses attributed to it).
+struct cachesim_result cachesim_tenant_stats(const cachesim* sim, unsigned tenant);
+
+// Writes the per-set and per-region heatmap report. Returns 0 on success,
+// -1 if the heatmap is disabled or the file cannot be written.
+int cachesim_write_heatmap(const cachesim* sim, const char* path);
+
+void cachesim_destroy(cachesim* sim);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
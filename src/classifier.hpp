@@ -0,0 +1,213 @@
+#ifndef CLASSIFIER_HPP
+#define CLASSIFIER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- Flat Hash Table ---
+// Open addressing with linear probing and backward-shift deletion. Keys and
+// values live in two contiguous arrays, so lookups never chase pointers.
+// Home buckets come from the high bits of a Fibonacci hash, so keys that
+// differ only in their upper bits (power-of-two strides) still spread out.
+// Keys are 64-bit so line tags can carry an address-space id.
+class FlatTable {
+public:
+    enum : uint64_t { EMPTY = UINT64_MAX };
+
+    FlatTable() : count(0), mask(0), shift(63) {}
+
+    void reset(size_t expected) {
+        size_t capacity = 16;
+        while (capacity < expected * 2) capacity <<= 1;
+        keys.assign(capacity, EMPTY);
+        values.assign(capacity, 0);
+        mask = capacity - 1;
+        shift = 64;
+        for (size_t c = capacity; c > 1; c >>= 1) shift--;
+        count = 0;
+    }
+
+    uint32_t* find(uint64_t key) {
+        for (size_t i = home(key); keys[i] != EMPTY; i = (i + 1) & mask) {
+            if (keys[i] == key) return &values[i];
+        }
+        return nullptr;
+    }
+
+    // Inserts or overwrites. Returns true if the key was not present.
+    bool insert(uint64_t key, uint32_t value) {
+        if ((count + 1) * 2 > keys.size()) grow();
+        size_t i = home(key);
+        for (; keys[i] != EMPTY; i = (i + 1) & mask) {
+            if (keys[i] == key) {
+                values[i] = value;
+                return false;
+            }
+        }
+        keys[i] = key;
+        values[i] = value;
+        count++;
+        return true;
+    }
+
+    void erase(uint64_t key) {
+        size_t i = home(key);
+        while (keys[i] != key) {
+            if (keys[i] == EMPTY) return;
+            i = (i + 1) & mask;
+        }
+        // Shift following entries back so probe chains stay unbroken
+        size_t j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (keys[j] == EMPTY) break;
+            size_t h = home(keys[j]);
+            if (((j - h) & mask) >= ((j - i) & mask)) {
+                keys[i] = keys[j];
+                values[i] = values[j];
+                i = j;
+            }
+        }
+        keys[i] = EMPTY;
+        count--;
+    }
+
+private:
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> values;
+    size_t count, mask;
+    unsigned shift; // 64 - log2(capacity)
+
+    size_t home(uint64_t key) const {
+        return (size_t)((key * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    void grow() {
+        std::vector<uint64_t> oldKeys;
+        std::vector<uint32_t> oldValues;
+        oldKeys.swap(keys);
+        oldValues.swap(values);
+        reset(oldKeys.size());
+        for (size_t i = 0; i < oldKeys.size(); i++) {
+            if (oldKeys[i] != EMPTY) insert(oldKeys[i], oldValues[i]);
+        }
+    }
+};
+
+// --- Shadow Fully Associative LRU ---
+// Index-linked recency list over fixed arrays; no allocation after reset().
+class ShadowLRU {
+public:
+    void reset(unsigned capacity) {
+        this->capacity = capacity;
+        tags.assign(capacity, 0);
+        prev.assign(capacity, NIL);
+        next.assign(capacity, NIL);
+        head = tail = NIL;
+        used = 0;
+        slots.reset(capacity);
+    }
+
+    bool contains(uint64_t lineTag) {
+        return slots.find(lineTag) != nullptr;
+    }
+
+    // Touches a line and returns true if it was resident.
+    bool access(uint64_t lineTag) {
+        uint32_t* slot = slots.find(lineTag);
+        if (slot) {
+            moveToFront(*slot);
+            return true;
+        }
+        uint32_t s;
+        if (used < capacity) {
+            s = used++;
+        } else {
+            s = tail;
+            slots.erase(tags[s]);
+            unlink(s);
+        }
+        tags[s] = lineTag;
+        pushFront(s);
+        slots.insert(lineTag, s);
+        return false;
+    }
+
+private:
+    enum : uint32_t { NIL = UINT32_MAX };
+    std::vector<uint64_t> tags;
+    std::vector<uint32_t> prev, next;
+    uint32_t head, tail, used, capacity;
+    FlatTable slots;
+
+    void unlink(uint32_t s) {
+        if (prev[s] != NIL) next[prev[s]] = next[s]; else head = next[s];
+        if (next[s] != NIL) prev[next[s]] = prev[s]; else tail = prev[s];
+    }
+
+    void pushFront(uint32_t s) {
+        prev[s] = NIL;
+        next[s] = head;
+        if (head != NIL) prev[head] = s;
+        head = s;
+        if (tail == NIL) tail = s;
+    }
+
+    void moveToFront(uint32_t s) {
+        if (head == s) return;
+        unlink(s);
+        pushFront(s);
+    }
+};
+
+// --- 3C Miss Classifier ---
+// Observes every access at cache-line granularity. A miss in the primary model
+// is compulsory if the line was never touched before, capacity if a fully
+// associative LRU cache of equal size also misses, and conflict otherwise.
+class MissClassifier {
+public:
+    enum Kind { Compulsory, Capacity, Conflict };
+
+    void initialize(unsigned cacheLines, uint32_t offsetBits) {
+        this->offsetBits = offsetBits;
+        shadow.reset(cacheLines);
+        seen.reset(cacheLines);
+    }
+
+    // Touches every line covered by [addr, addr + numBytes) of one address
+    // space and returns the classification a miss on addr would receive.
+    Kind observe(uint32_t space, uint32_t addr, unsigned numBytes) {
+        uint32_t first = addr >> offsetBits;
+        uint32_t last = (addr + numBytes - 1) >> offsetBits;
+        if (last < first) last = first; // Wrapped past the top of the address space
+        uint64_t base = (uint64_t)space << 32;
+        Kind kind = classify(base | first);
+        for (uint32_t line = first + 1; line != last + 1; line++) {
+            classify(base | line);
+        }
+        return kind;
+    }
+
+    // Classifies a miss on addr without touching any state, for accesses the
+    // primary model does not allocate (reads of never-written addresses).
+    Kind peek(uint32_t space, uint32_t addr) {
+        uint64_t line = ((uint64_t)space << 32) | (addr >> offsetBits);
+        if (!seen.find(line)) return Compulsory;
+        return shadow.contains(line) ? Conflict : Capacity;
+    }
+
+private:
+    uint32_t offsetBits;
+    ShadowLRU shadow;
+    FlatTable seen;
+
+    Kind classify(uint64_t lineTag) {
+        bool firstTouch = seen.insert(lineTag, 0);
+        bool shadowHit = shadow.access(lineTag);
+        if (firstTouch) return Compulsory;
+        return shadowHit ? Conflict : Capacity;
+    }
+};
+
+#endif
@@ -0,0 +1,440 @@
+#ifndef ENGINE_HPP
+#define ENGINE_HPP
+
+#include "cachesim.h"
+#include "classifier.hpp"
+#include "partition.hpp"
+#include "banking.hpp"
+#include "tlb.hpp"
+#include "heatmap.hpp"
+#include "profile.h"
+#include <cmath>
+#include <vector>
+#include <list>
+#include <unordered_map>
+
+// Kernel-free cache models. These hold all cache state and statistics and are
+// driven one request at a time, either by the SystemC modules in
+// simulation.hpp or directly through the C library interface in cachesim.h.
+
+// Tags, memory keys and classifier/partition keys are 64-bit: the upper half
+// holds the address space of the request (the tenant, or 0 when all tenants
+// share one address space), so separate tenants never hit each other's lines.
+
+// --- Data Structures ---
+struct CacheLine {
+    bool valid;
+    uint64_t tag;
+    std::vector<uint8_t> data;
+
+    CacheLine() : valid(false), tag(0), data() {}
+    CacheLine(unsigned cacheLineSize) : valid(false), tag(0), data(cacheLineSize) {}
+};
+
+// --- Common Model Base ---
+class CacheModel {
+public:
+    cachesim_result stats;
+    std::unordered_map<uint64_t, uint8_t> memory;
+    std::vector<CacheLine> cache;
+    unsigned cacheLines, cacheLineSize, cacheLatency, memoryLatency;
+    uint32_t offsetBits, indexBits;
+    bool classifyMisses;
+    MissClassifier classifier;
+    BankScheduler banking;
+    Tlb tlb;
+    unsigned pageWalkLatency;
+    Heatmap heatmap;
+    bool sharedAddressSpace;
+    uint32_t space; // Address space of the current request
+
+    CacheModel() : stats(), cacheLines(0), cacheLineSize(0), cacheLatency(0),
+                   memoryLatency(0), offsetBits(0), indexBits(0), classifyMisses(false),
+                   pageWalkLatency(0), sharedAddressSpace(false), space(0) {}
+    virtual ~CacheModel() {}
+
+    virtual void initialize(unsigned cacheLines, unsigned cacheLineSize, unsigned cacheLatency, unsigned memoryLatency) {
+        this->cacheLines = cacheLines;
+        this->cacheLineSize = cacheLineSize;
+        this->cacheLatency = cacheLatency;
+        this->memoryLatency = memoryLatency;
+        offsetBits = std::log2(cacheLineSize);
+        indexBits = std::log2(cacheLines);
+        cache.assign(cacheLines, CacheLine(cacheLineSize));
+    }
+
+    // Applies geometry and the optional analysis/timing stages of a config.
+    void configure(const cachesim_config& config) {
+        initialize(config.cacheLines, config.cacheLineSize, config.cacheLatency, config.memoryLatency);
+        sharedAddressSpace = config.sharedAddressSpace != 0;
+        if (config.classifyMisses) enableMissClassification();
+        banking.initialize(config.issueWidth, config.numBanks, offsetBits);
+        if (config.tlbEntries) {
+            tlb.initialize(config.tlbEntries, config.tlbAssociativity, config.pageSize);
+            pageWalkLatency = config.pageWalkLatency;
+        }
+        if (config.regionSize) {
+            heatmap.initialize(numSets(), offsetBits, config.regionSize,
+                               config.heatmapTopN ? config.heatmapTopN : 10);
+        }
+    }
+
+    virtual unsigned numSets() const = 0;
+
+    void enableMissClassification() {
+        classifyMisses = true;
+        classifier.initialize(cacheLines, offsetBits);
+    }
+
+    // Processes one request. Returns false on a data fault (read of an
+    // address that is neither cached nor in memory); data is then all ones.
+    bool access(const cachesim_request& req, uint32_t& data) {
+        PROFILE_REQUEST();
+        if (heatmap.active()) heatmap.prefetch(req.addr);
+        bool ok = true, miss = false;
+        if (req.we == 1) {
+            // Write Operation
+            data = req.data;
+            writeDataInCache(req.addr, req.data);
+            writeDataInMemory(req.addr, req.data);
+        } else if (readDataInCache(req.addr, data)) {
+            // Read Hit
+            stats.hits++;
+        } else {
+            // Read Miss
+            if (readDataInMemory(req.addr, data)) {
+                importMemoryBlockToCache(req.addr, data);
+            } else {
+                data = static_cast<uint32_t>(-1);
+                ok = false;
+            }
+            stats.misses++;
+            miss = true;
+        }
+
+        // The classifier only depends on its own history, so it can be fed
+        // after the access; faulting reads allocate nothing and are only peeked
+        if (classifyMisses) {
+            MissClassifier::Kind kind = ok
+                ? classifier.observe(space, req.addr, req.we == 1 ? bytesWritten(req.data) : 1)
+                : classifier.peek(space, req.addr);
+            if (miss) countMiss(kind);
+        }
+        if (heatmap.active()) heatmap.record(req.addr, miss);
+
+        // Single-ported caches take one cycle per request
+        stats.requests++;
+        if (banking.active()) {
+            stats.cycles += banking.issue(req.addr);
+            stats.bankConflicts = banking.conflictStalls;
+        } else {
+            stats.cycles++;
+        }
+
+        // Address translation: a TLB miss stalls for the page walk
+        if (tlb.active()) {
+            if (tlb.lookup(space, req.addr)) {
+                stats.tlbHits++;
+            } else {
+                stats.tlbMisses++;
+                stats.cycles += pageWalkLatency;
+            }
+        }
+        return ok;
+    }
+
+    void countMiss(MissClassifier::Kind kind) {
+        switch (kind) {
+            case MissClassifier::Compulsory: stats.compulsoryMisses++; break;
+            case MissClassifier::Capacity:   stats.capacityMisses++;   break;
+            case MissClassifier::Conflict:   stats.conflictMisses++;   break;
+        }
+    }
+
+    static unsigned bytesWritten(uint32_t data) {
+        unsigned numBytes = 0;
+        while (data > 0) { data >>= 8; numBytes++; }
+        return numBytes == 0 ? 1 : numBytes;
+    }
+
+    // Processes one request on behalf of a tenant of a shared cache. Each
+    // tenant has its own address space unless sharedAddressSpace is set.
+    virtual bool accessAs(unsigned tenant, const cachesim_request& req, uint32_t& data) {
+        space = sharedAddressSpace ? 0 : tenant;
+        return access(req, data);
+    }
+
+    // Key of a byte or line address within the current address space
+    uint64_t spaceKey(uint32_t addr) const {
+        return ((uint64_t)space << 32) | addr;
+    }
+
+    virtual bool readDataInCache(uint32_t addr, uint32_t &data) = 0;
+    virtual void writeDataInCache(uint32_t addr, uint32_t data) = 0;
+    virtual void importMemoryBlockToCache(uint32_t addr, uint32_t &data) = 0;
+
+    bool readDataInMemory(uint32_t addr, uint32_t &data) {
+        auto it = memory.find(spaceKey(addr));
+        if (it != memory.end()) {
+            data = it->second;
+            return true;
+        }
+        return false;
+    }
+
+    void writeDataInMemory(uint32_t addr, uint32_t data) {
+        int entered = 0;
+        while (data > 0) {
+            memory[spaceKey(addr + entered)] = data & 255;
+            entered++;
+            data >>= 8;
+            stats.primitiveGateCount += 10;
+        }
+        if (entered == 0 && data == 0) {
+            memory[spaceKey(addr)] = data;
+            stats.primitiveGateCount += 10;
+        }
+    }
+};
+
+// --- Direct Mapped Model ---
+class DirectMappedModel : public CacheModel {
+public:
+    bool writeTruncated; // Set when the last write ran past the final line
+
+    DirectMappedModel() : writeTruncated(false) {}
+
+    unsigned numSets() const override { return cacheLines; }
+
+    // Charges an eviction to the heatmap if the line holds another block
+    void noteReplacement(unsigned index, uint64_t tag) {
+        if (heatmap.active() && cache[index].valid && cache[index].tag != tag) {
+            uint64_t victim = ((uint64_t)(uint32_t)cache[index].tag << (indexBits + offsetBits)) | (index << offsetBits);
+            heatmap.evict((uint32_t)victim);
+        }
+    }
+
+    bool readDataInCache(uint32_t addr, uint32_t &data) override {
+        stats.primitiveGateCount += 20;
+        unsigned index = (addr / cacheLineSize) % cacheLines;
+        uint32_t offset = addr % cacheLineSize;
+        uint64_t tag = calcTagOfDirectMapped(addr);
+
+        if (cache[index].valid && cache[index].tag == tag) {
+            data = cache[index].data[offset];
+            stats.primitiveGateCount += 10;
+            return true;
+        }
+        return false;
+    }
+
+    void writeDataInCache(uint32_t addr, uint32_t data) override {
+        stats.primitiveGateCount += 20;
+        unsigned index = (addr / cacheLineSize) % cacheLines;
+        uint64_t tag = calcTagOfDirectMapped(addr);
+        uint32_t offset = addr % cacheLineSize;
+        writeTruncated = false;
+
+        int entered = 0;
+        while (data > 0) {
+            if (offset > (cacheLineSize - 1)) {
+                offset = 0;
+                index++;
+                stats.primitiveGateCount += 2;
+            }
+            if (index > (cacheLines - 1)) {
+                writeTruncated = true;
+                stats.primitiveGateCount += 1;
+                return;
+            }
+            entered++;
+            noteReplacement(index, tag);
+            cache[index].valid = true;
+            cache[index].tag = tag;
+            cache[index].data[offset] = data & 255;
+            offset++;
+            data = data >> 8;
+            stats.primitiveGateCount += 10;
+        }
+        if (entered == 0 && data == 0) {
+            noteReplacement(index, tag);
+            cache[index].valid = true;
+            cache[index].tag = tag;
+            cache[index].data[offset] = data;
+            stats.primitiveGateCount += 10;
+        }
+    }
+
+    void importMemoryBlockToCache(uint32_t addr, uint32_t &data) override {
+        stats.primitiveGateCount += 20;
+        unsigned index = (addr / cacheLineSize) % cacheLines;
+        uint64_t tag = calcTagOfDirectMapped(addr);
+        uint32_t offset = addr % cacheLineSize;
+        uint32_t startAddress = addr - (addr % cacheLineSize);
+
+        noteReplacement(index, tag);
+        for (int i = 0; i < (int)cacheLineSize; i++) {
+            cache[index].data[i] = memory[spaceKey(startAddress + i)];
+            stats.primitiveGateCount += 10;
+        }
+        cache[index].tag = tag;
+        cache[index].valid = true;
+        data = cache[index].data[offset];
+    }
+
+    uint64_t calcTagOfDirectMapped(uint32_t addr) {
+        stats.primitiveGateCount += 20;
+        return spaceKey(addr >> (indexBits + offsetBits));
+    }
+};
+
+// --- Fully Associative Model (LRU) ---
+class FullyAssociativeModel : public CacheModel {
+public:
+    std::list<uint64_t> tracker_lru;
+    std::unordered_map<uint64_t, std::list<uint64_t>::iterator> map_with_tags;
+    WayPartitioner partitioner;
+
+    unsigned numSets() const override { return 1; }
+
+    void initialize(unsigned cacheLines, unsigned cacheLineSize, unsigned cacheLatency, unsigned memoryLatency) override {
+        CacheModel::initialize(cacheLines, cacheLineSize, cacheLatency, memoryLatency);
+        tracker_lru.clear();
+        map_with_tags.clear();
+    }
+
+    void enablePartitioning(unsigned tenants, int policy, const unsigned* tenantWays, unsigned interval) {
+        partitioner.initialize(cacheLines, tenants, policy, tenantWays, interval);
+    }
+
+    bool accessAs(unsigned tenant, const cachesim_request& req, uint32_t& data) override {
+        space = sharedAddressSpace ? 0 : tenant;
+        if (partitioner.active()) {
+            partitioner.tenant = tenant;
+            partitioner.observe(spaceKey(req.addr >> offsetBits));
+        }
+        return access(req, data);
+    }
+
+    bool readDataInCache(uint32_t addr, uint32_t &data) override {
+        uint64_t tag = calctagFullAssociative(addr);
+        uint32_t offset = addr % cacheLineSize;
+        for (CacheLine &line : cache) {
+            stats.primitiveGateCount += 20;
+            if (line.valid && line.tag == tag) {
+                data = line.data[offset];
+                stats.primitiveGateCount += 10;
+                tracker_lru.erase(map_with_tags[tag]);
+                LRU_first_update(tag);
+                stats.primitiveGateCount += 20;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void writeDataInCache(uint32_t addr, uint32_t data) override {
+        stats.primitiveGateCount += 2;
+        unsigned numBytes = 0;
+        uint32_t temp = data;
+        while (temp > 0) { temp >>= 8; numBytes++; }
+        if (numBytes == 0) numBytes = 1;
+
+        while (numBytes > 0) {
+            uint32_t offset = addr % cacheLineSize;
+            uint64_t tag = calctagFullAssociative(addr);
+
+            if (map_with_tags.find(tag) != map_with_tags.end()) {
+                for (CacheLine &line : cache) {
+                    if (line.valid && line.tag == tag) {
+                        stats.primitiveGateCount += 10;
+                        line.data[offset] = data & 255;
+                        tracker_lru.erase(map_with_tags[tag]);
+                        LRU_first_update(tag);
+                        stats.primitiveGateCount += 1;
+                        break;
+                    }
+                }
+            } else {
+                CacheLine &line = allocateLine(tag, 1);
+                line.data[offset] = data & 255;
+                stats.primitiveGateCount += 10;
+                LRU_first_update(tag);
+                stats.primitiveGateCount += 2;
+            }
+            data >>= 8;
+            numBytes--;
+            addr++;
+            stats.primitiveGateCount += 3;
+        }
+    }
+
+    void importMemoryBlockToCache(uint32_t addr, uint32_t &data) override {
+        stats.primitiveGateCount += 4;
+        uint32_t startAddress = addr - (addr % cacheLineSize);
+        uint64_t tag = calctagFullAssociative(addr);
+        uint32_t offset = addr % cacheLineSize;
+
+        CacheLine &line = allocateLine(tag, 0);
+        for (int i = 0; i < (int)cacheLineSize; i++) {
+            line.data[i] = memory[spaceKey(startAddress + i)];
+            stats.primitiveGateCount += 1;
+        }
+        stats.primitiveGateCount += 10;
+        LRU_first_update(tag);
+        data = line.data[offset];
+    }
+
+    // Claims a free line, or evicts the least recently used one when full.
+    // Under way partitioning a tenant at its quota replaces its own LRU line.
+    // evictionGates is charged per eviction: the write path pays for it, the
+    // memory import path does not.
+    CacheLine& allocateLine(uint64_t tag, unsigned evictionGates) {
+        if (tracker_lru.size() == cacheLines || partitioner.mustReplaceOwn()) {
+            uint64_t tag_to_delete = chooseVictim();
+            tracker_lru.erase(map_with_tags[tag_to_delete]);
+            map_with_tags.erase(tag_to_delete);
+            partitioner.release(tag_to_delete);
+            if (heatmap.active()) heatmap.evict((uint32_t)tag_to_delete << offsetBits);
+            stats.primitiveGateCount += evictionGates;
+            for (CacheLine &line : cache) {
+                if (line.valid && line.tag == tag_to_delete) {
+                    line.tag = tag;
+                    partitioner.claim(tag);
+                    return line;
+                }
+            }
+        }
+        for (CacheLine &line : cache) {
+            if (!line.valid) {
+                line.valid = true;
+                line.tag = tag;
+                partitioner.claim(tag);
+                return line;
+            }
+        }
+        return cache.front(); // Unreachable: LRU size tracks valid lines
+    }
+
+    uint64_t chooseVictim() {
+        if (partitioner.active()) {
+            for (auto it = tracker_lru.rbegin(); it != tracker_lru.rend(); ++it) {
+                if (partitioner.replaceable(*it)) return *it;
+            }
+        }
+        return tracker_lru.back();
+    }
+
+    void LRU_first_update(uint64_t tag) {
+        tracker_lru.push_front(tag);
+        stats.primitiveGateCount += 20;
+        map_with_tags[tag] = tracker_lru.begin();
+    }
+
+    uint64_t calctagFullAssociative(uint32_t addr) {
+        stats.primitiveGateCount += 2;
+        return spaceKey(addr >> offsetBits);
+    }
+};
+
+#endif
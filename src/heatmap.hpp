@@ -0,0 +1,124 @@
+#ifndef HEATMAP_HPP
+#define HEATMAP_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// --- Address-Region Heatmap and Per-Set Conflict Profiler ---
+// Counts accesses, misses and evictions per cache set and per fixed-size
+// address region. Both are plain counter arrays indexed directly by address
+// bits and sized once in initialize(), so the hot path is two array updates.
+// Evictions are charged to the set and region of the evicted line. Set
+// counters are 64-bit (a fully associative cache has a single set that sees
+// every request). Region counters are 32-bit to keep the region array at
+// 12 MiB for 4 KiB regions, and saturate at UINT32_MAX instead of wrapping.
+class Heatmap {
+public:
+    struct SetCounters {
+        uint64_t accesses, misses, evictions;
+    };
+
+    struct RegionCounters {
+        uint32_t accesses, misses, evictions;
+    };
+
+    Heatmap() : setMask(0), offsetBits(0), regionBits(0), topN(0) {}
+
+    bool active() const { return regionBits != 0; }
+
+    // regionSize must be a power of two of at least 4 KiB, which bounds the
+    // region array to 2^20 buckets for the 32-bit address space.
+    void initialize(unsigned sets, uint32_t offsetBits, unsigned regionSize, unsigned topN) {
+        this->offsetBits = offsetBits;
+        this->topN = topN;
+        setMask = sets - 1;
+        regionBits = std::log2(regionSize);
+        setCounters.assign(sets, SetCounters());
+        regionCounters.assign(size_t(1) << (32 - regionBits), RegionCounters());
+    }
+
+    // Starts loading the region bucket early; record() comes after the access
+    void prefetch(uint32_t addr) const {
+        __builtin_prefetch(&regionCounters[addr >> regionBits], 1);
+    }
+
+    void record(uint32_t addr, bool miss) {
+        SetCounters& set = setCounters[(addr >> offsetBits) & setMask];
+        RegionCounters& region = regionCounters[addr >> regionBits];
+        set.accesses++;
+        set.misses += miss;
+        saturatingAdd(region.accesses, 1);
+        saturatingAdd(region.misses, miss);
+    }
+
+    void evict(uint32_t victimAddr) {
+        setCounters[(victimAddr >> offsetBits) & setMask].evictions++;
+        saturatingAdd(regionCounters[victimAddr >> regionBits].evictions, 1);
+    }
+
+    // Writes the top-N thrashing lists followed by every non-zero row.
+    bool write(FILE* out) const {
+        std::fprintf(out, "# sets=%zu region_size=%lu\n",
+                     setCounters.size(), 1UL << regionBits);
+        writeSection(out, "top sets by evictions", "set", setCounters, 0, topN);
+        writeSection(out, "top regions by evictions", "region", regionCounters, regionBits, topN);
+        writeSection(out, "sets", "set", setCounters, 0, 0);
+        writeSection(out, "regions", "region", regionCounters, regionBits, 0);
+        return !std::ferror(out);
+    }
+
+private:
+    uint32_t setMask, offsetBits, regionBits;
+    unsigned topN;
+    std::vector<SetCounters> setCounters;
+    std::vector<RegionCounters> regionCounters;
+
+    static void saturatingAdd(uint32_t& counter, uint32_t n) {
+        counter += (counter != UINT32_MAX) ? n : 0;
+    }
+
+    // Lists non-zero rows; limit > 0 ranks them by evictions, then misses.
+    // Regions are labelled by base address, sets by index.
+    template <typename Counters>
+    static void writeSection(FILE* out, const char* title, const char* label,
+                             const std::vector<Counters>& counters, uint32_t shift, unsigned limit) {
+        std::vector<uint32_t> rows;
+        for (size_t i = 0; i < counters.size(); i++) {
+            if (counters[i].accesses || counters[i].evictions) rows.push_back((uint32_t)i);
+        }
+        if (limit) {
+            size_t n = std::min<size_t>(limit, rows.size());
+            std::partial_sort(rows.begin(), rows.begin() + n, rows.end(), [&](uint32_t a, uint32_t b) {
+                if (counters[a].evictions != counters[b].evictions) return counters[a].evictions > counters[b].evictions;
+                return counters[a].misses > counters[b].misses;
+            });
+            rows.resize(n);
+        }
+
+        std::fprintf(out, "# %s\n%s,accesses,misses,evictions\n", title, label);
+        for (uint32_t i : rows) {
+            const Counters& c = counters[i];
+            if (shift) {
+                std::fprintf(out, "0x%08x,%llu,%llu,%llu\n", (uint32_t)((uint64_t)i << shift),
+                             (unsigned long long)c.accesses, (unsigned long long)c.misses,
+                             (unsigned long long)c.evictions);
+            } else {
+                std::fprintf(out, "%u,%llu,%llu,%llu\n", i, (unsigned long long)c.accesses,
+                             (unsigned long long)c.misses, (unsigned long long)c.evictions);
+            }
+        }
+    }
+};
+
+// Writes a heatmap report to path. Returns 0 on success, -1 on I/O failure.
+inline int writeHeatmap(const Heatmap& heatmap, const char* path) {
+    FILE* out = std::fopen(path, "w");
+    if (!out) return -1;
+    bool ok = heatmap.write(out);
+    return (std::fclose(out) == 0 && ok) ? 0 : -1;
+}
+
+#endif
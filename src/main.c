@@ -3,25 +3,20 @@
 #include <string.h>
 #include <getopt.h>
 #include <stdint.h>
+#include "cachesim.h"
+#include "profile.h"
+#include "trace.h"
+
+// Front-end names for the library's request/result types
+typedef struct cachesim_request Request;
+typedef struct cachesim_result Result;
 
 // --- Prototypes ---
 void parse_commands(int argc, char const *argv[]);
 void help();
 int readfile(const char *file);
-
-// --- Structures ---
-struct Result {
-    size_t cycles;
-    size_t misses;
-    size_t hits;
-    size_t primitiveGateCount;
-};
-
-struct Request {
-    uint32_t addr;
-    uint32_t data;
-    int we; // Write Enable
-};
+int run_shared(const struct cachesim_config *config);
+void print_result(const Result *result);
 
 // --- Simulation Settings (Defaults) ---
 static int cycles = 3000;
@@ -30,49 +25,231 @@ static unsigned cacheLines = 256;
 static unsigned cacheLineSize = 32;
 static unsigned cacheLatency = 1;
 static unsigned memoryLatency = 5;
+static int classifyMisses = 0;
+static unsigned issueWidth = 1;
+static unsigned numBanks = 1;
+static unsigned tlbEntries = 0;
+static unsigned tlbAssociativity = 0;
+static unsigned pageSize = 4096;
+static unsigned pageWalkLatency = 20;
+static const char *heatmapFile = NULL;
+static unsigned regionSize = 4096;
+static unsigned heatmapTopN = 10;
 static const char *inputFile = NULL;
 static const char *tracefile = NULL;
 
-static struct Request* requests;
+// Shared cache mode (more than one input trace)
+#define MAX_TRACES 64
+static const char *inputFiles[MAX_TRACES];
+static unsigned numInputs = 0;
+static int interleave = INTERLEAVE_ROUND_ROBIN;
+static unsigned weights[MAX_TRACES];
+static unsigned numWeights = 0;
+static int partitionPolicy = CACHESIM_PARTITION_NONE;
+static unsigned tenantWays[MAX_TRACES];
+static unsigned numTenantWays = 0;
+static unsigned repartitionInterval = 0;
+static int sharedAddressSpace = 0;
+#ifdef CACHESIM_PROFILE
+static const char *profileFile = NULL;
+#endif
+
+static Request* requests;
 static size_t numRequests = 0;
 
 // External SystemC Simulation Engine
-extern struct Result run_simulation(int cycles, int directMapped, unsigned cacheLines,
-                                    unsigned cacheLineSize, unsigned cacheLatency,
-                                    unsigned memoryLatency, size_t numRequests,
-                                    struct Request requests[], const char* tracefile);
+extern Result run_simulation(int cycles, const struct cachesim_config* config,
+                             size_t numRequests, Request requests[],
+                             const char* tracefile, const char* heatmapFile);
 
 int main(int argc, char const *argv[]) {
     // 1. CLI Argument Parsing
     parse_commands(argc, argv);
 
+    struct cachesim_config config = {0};
+    config.directMapped = directMapped;
+    config.cacheLines = cacheLines;
+    config.cacheLineSize = cacheLineSize;
+    config.cacheLatency = cacheLatency;
+    config.memoryLatency = memoryLatency;
+    config.classifyMisses = classifyMisses;
+    config.issueWidth = issueWidth;
+    config.numBanks = numBanks;
+    config.tlbEntries = tlbEntries;
+    config.tlbAssociativity = tlbAssociativity;
+    config.pageSize = pageSize;
+    config.pageWalkLatency = pageWalkLatency;
+    if (heatmapFile) {
+        config.regionSize = regionSize;
+        config.heatmapTopN = heatmapTopN;
+    }
+
+    // Several traces: stream them into one shared cache
+    if (numInputs > 1) {
+        config.numTenants = numInputs;
+        config.partitionPolicy = partitionPolicy;
+        config.tenantWays = tenantWays;
+        config.repartitionInterval = repartitionInterval;
+        config.sharedAddressSpace = sharedAddressSpace;
+        return run_shared(&config);
+    }
+
     // 2. Trace Ingestion
+    PROFILE_PHASE_BEGIN(PROFILE_PARSE);
     if (readfile(inputFile) != 0) {
         fprintf(stderr, "Error: Could not process CSV input file.\n");
         return EXIT_FAILURE;
     }
+    PROFILE_PHASE_END(PROFILE_PARSE, numRequests);
 
     // 3. Simulation Execution
-    struct Result result = run_simulation(
-        cycles, directMapped, cacheLines, cacheLineSize, 
-        cacheLatency, memoryLatency, numRequests, requests, tracefile
-    );
+    Result result = run_simulation(cycles, &config, numRequests, requests,
+                                   tracefile, heatmapFile);
 
     // 4. Output Results
+    PROFILE_PHASE_BEGIN(PROFILE_REPORTING);
     printf("--- Simulation Results ---\n");
-    printf("Total Cycles: %zu\n", result.cycles);
-    printf("Cache Misses: %zu\n", result.misses);
-    printf("Cache Hits:   %zu\n", result.hits);
+    print_result(&result);
     printf("Logic Gates:  %zu\n", result.primitiveGateCount);
+    fflush(stdout);
+    PROFILE_PHASE_END(PROFILE_REPORTING, 1);
+
+#ifdef CACHESIM_PROFILE
+    if (profileFile && profile_write_json(profileFile) != 0) {
+        perror("Profile Write Error");
+    }
+#endif
 
     // 5. Cleanup
     free(requests);
     return EXIT_SUCCESS;
 }
 
+void print_result(const Result *result) {
+    printf("Total Cycles: %zu\n", result->cycles);
+    printf("Cache Misses: %zu\n", result->misses);
+    if (classifyMisses) {
+        printf("  Compulsory: %zu\n", result->compulsoryMisses);
+        printf("  Capacity:   %zu\n", result->capacityMisses);
+        printf("  Conflict:   %zu\n", result->conflictMisses);
+    }
+    printf("Cache Hits:   %zu\n", result->hits);
+    if (issueWidth > 1 || numBanks > 1) {
+        double perCycle = result->cycles ? (double)result->requests / result->cycles : 0.0;
+        printf("Requests/Cycle: %.3f\n", perCycle);
+        printf("Bank Stalls:  %zu\n", result->bankConflicts);
+    }
+    if (tlbEntries) {
+        printf("TLB Hits:     %zu\n", result->tlbHits);
+        printf("TLB Misses:   %zu\n", result->tlbMisses);
+    }
+}
+
+// Streams all input traces through one shared cache, one tenant per trace.
+// Requests are merged on the fly and handed to the library in per-tenant runs.
+int run_shared(const struct cachesim_config *config) {
+    struct TraceStream streams[MAX_TRACES];
+    struct TraceMerge merge;
+    Request batch[256];
+    size_t batchLen = 0;
+    unsigned batchTenant = 0, tenant;
+    Request req;
+    int truncated = 0;
+
+    if (tracefile) {
+        fprintf(stderr, "Warning: VCD tracing is not available with multiple traces.\n");
+    }
+
+    PROFILE_PHASE_BEGIN(PROFILE_ELABORATION);
+    cachesim *sim = cachesim_create(config);
+    if (!sim) {
+        fprintf(stderr, "Error: Invalid shared cache configuration.\n");
+        return EXIT_FAILURE;
+    }
+    for (unsigned i = 0; i < numInputs; i++) {
+        if (trace_open(&streams[i], inputFiles[i]) != 0) {
+            while (i > 0) trace_close(&streams[--i]);
+            cachesim_destroy(sim);
+            return EXIT_FAILURE;
+        }
+    }
+    merge_init(&merge, streams, numInputs, interleave, weights);
+    PROFILE_PHASE_END(PROFILE_ELABORATION, 0);
+
+    // Parsing is timed per batch; simulation time is recorded by the library
+    PROFILE_PHASE_BEGIN(PROFILE_PARSE);
+    while (merge_next(&merge, &tenant, &req)) {
+        if (batchLen == sizeof(batch) / sizeof(batch[0]) || (batchLen > 0 && tenant != batchTenant)) {
+            PROFILE_PHASE_END(PROFILE_PARSE, batchLen);
+            cachesim_access_tenant_batch(sim, batchTenant, batch, batchLen, NULL);
+            batchLen = 0;
+            // The limit counts model cycles (multi-issue, page walks), checked per batch
+            if (cachesim_stats(sim).cycles >= (size_t)cycles) {
+                truncated = 1; // Cycle limit reached before the traces ran out
+                break;
+            }
+            PROFILE_PHASE_BEGIN(PROFILE_PARSE);
+        }
+        batchTenant = tenant;
+        batch[batchLen++] = req;
+    }
+    if (!truncated) {
+        PROFILE_PHASE_END(PROFILE_PARSE, batchLen);
+        cachesim_access_tenant_batch(sim, batchTenant, batch, batchLen, NULL);
+        if (cachesim_stats(sim).cycles > (size_t)cycles) truncated = 1;
+    }
+
+    // Output Results (including the heatmap export)
+    PROFILE_PHASE_BEGIN(PROFILE_REPORTING);
+    if (heatmapFile && cachesim_write_heatmap(sim, heatmapFile) != 0) {
+        perror("Heatmap Write Error");
+    }
+    Result result = cachesim_stats(sim);
+    if (truncated) result.cycles = SIZE_MAX;
+    printf("--- Simulation Results ---\n");
+    print_result(&result);
+    printf("Logic Gates:  %zu\n", result.primitiveGateCount);
+    for (unsigned i = 0; i < numInputs; i++) {
+        Result share = cachesim_tenant_stats(sim, i);
+        if (truncated) share.cycles = SIZE_MAX;
+        printf("--- Tenant %u: %s ---\n", i, inputFiles[i]);
+        print_result(&share);
+    }
+    fflush(stdout);
+    PROFILE_PHASE_END(PROFILE_REPORTING, 1);
+
+#ifdef CACHESIM_PROFILE
+    if (profileFile && profile_write_json(profileFile) != 0) {
+        perror("Profile Write Error");
+    }
+#endif
+
+    for (unsigned i = 0; i < numInputs; i++) trace_close(&streams[i]);
+    cachesim_destroy(sim);
+    return EXIT_SUCCESS;
+}
+
+// Parses a comma-separated list of positive integers. Returns the entry count.
+static unsigned parse_list(const char *arg, unsigned out[], const char *option) {
+    unsigned count = 0;
+    const char *p = arg;
+    while (*p) {
+        char *endptr;
+        long value = strtol(p, &endptr, 10);
+        if (endptr == p || value <= 0 || count == MAX_TRACES || (*endptr != ',' && *endptr != '\0')) {
+            fprintf(stderr, "Error: %s expects positive integers separated by commas: %s\n", option, arg);
+            exit(EXIT_FAILURE);
+        }
+        out[count++] = (unsigned)value;
+        p = (*endptr == ',') ? endptr + 1 : endptr;
+    }
+    return count;
+}
+
 void parse_commands(int argc, char const *argv[]) {
     size_t check_cycle = 0;
     size_t check_type = 0;
+    const char *sharedOption = NULL; // First shared cache option seen
 
     for (int i = 1; i < argc; i++) {
         // Cycles Configuration
@@ -130,6 +307,79 @@ void parse_commands(int argc, char const *argv[]) {
                 }
             }
         } 
+        // Multi-Issue Banking
+        else if (strcmp(argv[i], "--issueWidth") == 0) {
+            if (i + 1 < argc) {
+                char *endptr;
+                issueWidth = (unsigned)strtol(argv[++i], &endptr, 10);
+                if (*endptr != '\0' || issueWidth == 0) {
+                    fprintf(stderr, "Error: issueWidth must be a positive integer: %s\n", argv[i]);
+                    exit(EXIT_FAILURE);
+                }
+            }
+        } 
+        else if (strcmp(argv[i], "--banks") == 0) {
+            if (i + 1 < argc) {
+                char *endptr;
+                numBanks = (unsigned)strtol(argv[++i], &endptr, 10);
+                if (*endptr != '\0' || !(numBanks > 0 && (numBanks & (numBanks - 1)) == 0)) {
+                    fprintf(stderr, "Error: banks must be a power of two: %s\n", argv[i]);
+                    exit(EXIT_FAILURE);
+                }
+            }
+        } 
+        // Address Translation
+        else if (strcmp(argv[i], "--tlbEntries") == 0 || strcmp(argv[i], "--tlbWays") == 0) {
+            if (i + 1 < argc) {
+                const char *option = argv[i];
+                char *endptr;
+                unsigned value = (unsigned)strtol(argv[++i], &endptr, 10);
+                if (*endptr != '\0' || !(value > 0 && (value & (value - 1)) == 0)) {
+                    fprintf(stderr, "Error: %s must be a power of two: %s\n", option, argv[i]);
+                    exit(EXIT_FAILURE);
+                }
+                if (strcmp(option, "--tlbEntries") == 0) tlbEntries = value;
+                else tlbAssociativity = value;
+            }
+        } 
+        else if (strcmp(argv[i], "--pageSize") == 0) {
+            if (i + 1 < argc) {
+                char *endptr;
+                unsigned long value = strtoul(argv[++i], &endptr, 10);
+                // Accept a K/M/G suffix (e.g. 4K, 2M, 1G)
+                if (*endptr == 'K') { value <<= 10; endptr++; }
+                else if (*endptr == 'M') { value <<= 20; endptr++; }
+                else if (*endptr == 'G') { value <<= 30; endptr++; }
+                if (*endptr != '\0' || value == 0 || value > (1UL << 31) || (value & (value - 1)) != 0) {
+                    fprintf(stderr, "Error: pageSize must be a power of two up to 2G: %s\n", argv[i]);
+                    exit(EXIT_FAILURE);
+                }
+                pageSize = (unsigned)value;
+            }
+        } 
+        else if (strcmp(argv[i], "--pageWalkLatency") == 0) {
+            if (i + 1 < argc) pageWalkLatency = (unsigned)atoi(argv[++i]);
+        } 
+        // Heatmap Profiler
+        else if (strcmp(argv[i], "--heatmap") == 0) {
+            if (i + 1 < argc) heatmapFile = argv[++i];
+        } 
+        else if (strcmp(argv[i], "--regionSize") == 0) {
+            if (i + 1 < argc) {
+                char *endptr;
+                unsigned long value = strtoul(argv[++i], &endptr, 10);
+                if (*endptr == 'K') { value <<= 10; endptr++; }
+                else if (*endptr == 'M') { value <<= 20; endptr++; }
+                if (*endptr != '\0' || value < 4096 || value > (1UL << 31) || (value & (value - 1)) != 0) {
+                    fprintf(stderr, "Error: regionSize must be a power of two of at least 4K: %s\n", argv[i]);
+                    exit(EXIT_FAILURE);
+                }
+                regionSize = (unsigned)value;
+            }
+        } 
+        else if (strcmp(argv[i], "--top") == 0) {
+            if (i + 1 < argc) heatmapTopN = (unsigned)atoi(argv[++i]);
+        } 
         // Latency and Debug
         else if (strcmp(argv[i], "--cacheLatency") == 0) {
             if (i + 1 < argc) cacheLatency = (unsigned)atoi(argv[++i]);
@@ -137,6 +387,72 @@ void parse_commands(int argc, char const *argv[]) {
         else if (strcmp(argv[i], "--memoryLatency") == 0) {
             if (i + 1 < argc) memoryLatency = (unsigned)atoi(argv[++i]);
         } 
+        else if (strcmp(argv[i], "--classify") == 0) {
+            classifyMisses = 1;
+        } 
+        else if (strcmp(argv[i], "--profile") == 0 || strcmp(argv[i], "--profile-latency") == 0) {
+#ifdef CACHESIM_PROFILE
+            if (strcmp(argv[i], "--profile-latency") == 0) {
+                profile_enable_latency();
+            } else if (i + 1 < argc) {
+                profileFile = argv[++i];
+            }
+#else
+            fprintf(stderr, "Error: %s requires a build with PROFILE=1.\n", argv[i]);
+            exit(EXIT_FAILURE);
+#endif
+        } 
+        // Shared Cache (multiple traces)
+        else if (strcmp(argv[i], "--interleave") == 0) {
+            sharedOption = argv[i];
+            if (i + 1 < argc) {
+                i++;
+                if (strcmp(argv[i], "rr") == 0) interleave = INTERLEAVE_ROUND_ROBIN;
+                else if (strcmp(argv[i], "weighted") == 0) interleave = INTERLEAVE_WEIGHTED;
+                else if (strcmp(argv[i], "timestamp") == 0) interleave = INTERLEAVE_TIMESTAMP;
+                else {
+                    fprintf(stderr, "Error: Unknown interleave policy: %s\n", argv[i]);
+                    exit(EXIT_FAILURE);
+                }
+            }
+        } 
+        else if (strcmp(argv[i], "--weights") == 0) {
+            sharedOption = argv[i];
+            if (i + 1 < argc) numWeights = parse_list(argv[++i], weights, "--weights");
+        } 
+        else if (strcmp(argv[i], "--partition") == 0) {
+            sharedOption = argv[i];
+            if (i + 1 < argc) {
+                i++;
+                if (strcmp(argv[i], "none") == 0) partitionPolicy = CACHESIM_PARTITION_NONE;
+                else if (strcmp(argv[i], "static") == 0) partitionPolicy = CACHESIM_PARTITION_STATIC;
+                else if (strcmp(argv[i], "utility") == 0) partitionPolicy = CACHESIM_PARTITION_UTILITY;
+                else {
+                    fprintf(stderr, "Error: Unknown partition policy: %s\n", argv[i]);
+                    exit(EXIT_FAILURE);
+                }
+            }
+        } 
+        else if (strcmp(argv[i], "--ways") == 0) {
+            sharedOption = argv[i];
+            if (i + 1 < argc) numTenantWays = parse_list(argv[++i], tenantWays, "--ways");
+        } 
+        else if (strcmp(argv[i], "--repartition") == 0) {
+            sharedOption = argv[i];
+            if (i + 1 < argc) {
+                char *endptr;
+                long value = strtol(argv[++i], &endptr, 10);
+                if (*endptr != '\0' || value <= 0) {
+                    fprintf(stderr, "Error: repartition must be a positive integer: %s\n", argv[i]);
+                    exit(EXIT_FAILURE);
+                }
+                repartitionInterval = (unsigned)value;
+            }
+        } 
+        else if (strcmp(argv[i], "--sharedAddressSpace") == 0) {
+            sharedOption = argv[i];
+            sharedAddressSpace = 1;
+        } 
         else if (strcmp(argv[i], "--tf") == 0) {
             if (i + 1 < argc) tracefile = argv[++i];
         } 
@@ -144,21 +460,84 @@ void parse_commands(int argc, char const *argv[]) {
             help();
             exit(EXIT_SUCCESS);
         } 
-        // Input File (Positional Argument)
+        // Input Files (Positional Arguments)
         else {
+            if (numInputs == MAX_TRACES) {
+                fprintf(stderr, "Error: At most %d input traces are supported.\n", MAX_TRACES);
+                exit(EXIT_FAILURE);
+            }
             inputFile = argv[i];
+            inputFiles[numInputs++] = argv[i];
         }
     }
+
+    // Shared cache options must describe every trace
+    if (sharedOption && numInputs < 2) {
+        fprintf(stderr, "Error: %s requires more than one input trace.\n", sharedOption);
+        exit(EXIT_FAILURE);
+    }
+    if (interleave == INTERLEAVE_WEIGHTED && numWeights != numInputs) {
+        fprintf(stderr, "Error: --weights needs one entry per input trace.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (partitionPolicy == CACHESIM_PARTITION_STATIC && numTenantWays != numInputs) {
+        fprintf(stderr, "Error: --ways needs one entry per input trace.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (numWeights && interleave != INTERLEAVE_WEIGHTED) {
+        fprintf(stderr, "Error: --weights requires --interleave weighted.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (numTenantWays && partitionPolicy != CACHESIM_PARTITION_STATIC) {
+        fprintf(stderr, "Error: --ways requires --partition static.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (repartitionInterval && partitionPolicy != CACHESIM_PARTITION_UTILITY) {
+        fprintf(stderr, "Error: --repartition requires --partition utility.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (partitionPolicy != CACHESIM_PARTITION_NONE && directMapped) {
+        fprintf(stderr, "Error: Way partitioning requires --fullassociative.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // TLB geometry
+    if (tlbAssociativity && !tlbEntries) {
+        fprintf(stderr, "Error: --tlbWays requires --tlbEntries.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (tlbAssociativity > tlbEntries) {
+        fprintf(stderr, "Error: --tlbWays must not exceed --tlbEntries.\n");
+        exit(EXIT_FAILURE);
+    }
 }
 
 void help() {
-    printf("Usage: cache_simulator [options] <input_file>\n");
+    printf("Usage: cache_simulator [options] <input_file> [<input_file>...]\n");
     printf("Options:\n");
     printf("  -c, --cycles <n>       Max simulation cycles\n");
     printf("  --directmapped         Model direct-mapped cache (default)\n");
     printf("  --fullassociative      Model fully associative cache\n");
     printf("  --cacheLineSize <n>    Size in bytes (must be power of 2)\n");
     printf("  --cacheLines <n>       Number of lines (must be power of 2)\n");
+    printf("  --issueWidth <n>       Requests issued per cycle (multi-issue mode)\n");
+    printf("  --banks <n>            Cache banks, selected by line address (power of 2)\n");
+    printf("  --tlbEntries <n>       Enable a TLB with n entries (power of 2)\n");
+    printf("  --tlbWays <n>          TLB associativity (default: fully associative)\n");
+    printf("  --pageSize <size>      Page size, e.g. 4K (default), 2M, 1G\n");
+    printf("  --pageWalkLatency <n>  Cycles added per TLB miss (default 20)\n");
+    printf("  --heatmap <filename>   Write per-set/per-region access, miss and eviction counts\n");
+    printf("  --regionSize <size>    Heatmap region bucket, e.g. 4K (default), 64K\n");
+    printf("  --top <n>              Entries in each thrashing list (default 10)\n");
+    printf("  --classify             Break misses down into compulsory/capacity/conflict\n");
+    printf("  --profile <filename>   Write a JSON performance report (PROFILE=1 builds)\n");
+    printf("  --profile-latency      Add per-request latency histogram to the report\n");
+    printf("  --interleave <policy>  Merge of several traces: rr (default), weighted, timestamp\n");
+    printf("  --weights <a,b,...>    Requests per turn for each trace (weighted)\n");
+    printf("  --partition <policy>   Shared cache partitioning: none (default), static, utility\n");
+    printf("  --ways <a,b,...>       Lines reserved per trace (static partitioning)\n");
+    printf("  --repartition <n>      Accesses between utility-based re-partitions\n");
+    printf("  --sharedAddressSpace   Traces address one memory (default: one address space each)\n");
     printf("  --tf <filename>        VCD tracefile output path\n");
     printf("  -h, --help             Show this help message\n");
 }
@@ -183,7 +562,7 @@ int readfile(const char *filename) {
         numRequests++;
     }
 
-    requests = malloc(numRequests * sizeof(struct Request));
+    requests = malloc(numRequests * sizeof(Request));
     if (!requests) {
         perror("Memory Allocation Error");
         fclose(file);
@@ -192,43 +571,14 @@ int readfile(const char *filename) {
 
     rewind(file);
     size_t counter = 0;
+    size_t lineNumber = 0;
 
     // Phase 2: Parse CSV data
     while (fgets(line, sizeof(line), file) && counter < numRequests) {
-        char *pos = strchr(line, '\n');
-        if (pos) *pos = '\0';
-
-        char *data[3];
-        int data_count = 0;
-        char *token = strtok(line, ",");
-        
-        while (token && data_count < 3) {
-            data[data_count++] = token;
-            token = strtok(NULL, ",");
-        }
-
-        // Parse Operation (W/R)
-        if (strcmp(data[0], "W") == 0) {
-            requests[counter].we = 1;
-        } else if (strcmp(data[0], "R") == 0) {
-            requests[counter].we = 0;
-        } else {
-            fprintf(stderr, "Syntax Error: Line %zu has invalid operation '%s'\n", counter + 1, data[0]);
-            continue;
-        }
-
-        // Parse Hex Address
-        char *endptr;
-        requests[counter].addr = (uint32_t)strtoul(data[1], &endptr, 16);
-        
-        // Parse Data (only for writes)
-        if (requests[counter].we == 1 && data_count == 3) {
-            requests[counter].data = (uint32_t)strtoul(data[2], &endptr, 10);
-        } else {
-            requests[counter].data = 0;
+        lineNumber++;
+        if (parse_request_line(line, lineNumber, &requests[counter], NULL) == 0) {
+            counter++;
         }
-        
-        counter++;
     }
 
     numRequests = counter;
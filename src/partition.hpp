@@ -0,0 +1,143 @@
+#ifndef PARTITION_HPP
+#define PARTITION_HPP
+
+#include "cachesim.h"
+#include "classifier.hpp"
+#include <algorithm>
+#include <vector>
+
+// --- Way Partitioner ---
+// Tracks which tenant owns each resident line of a shared fully associative
+// cache and enforces per-tenant line quotas on replacement. Quotas are either
+// fixed (CAT-style) or recomputed periodically from per-tenant utility
+// monitors (UCP lookahead). Inactive unless initialize() is called with a
+// policy other than CACHESIM_PARTITION_NONE.
+class WayPartitioner {
+public:
+    unsigned tenant; // Tenant issuing the current request
+
+    WayPartitioner() : tenant(0), policy(CACHESIM_PARTITION_NONE), ways(0),
+                       interval(0), accesses(0) {}
+
+    bool active() const { return policy != CACHESIM_PARTITION_NONE; }
+
+    void initialize(unsigned ways, unsigned tenants, int policy,
+                    const unsigned* staticWays, unsigned interval) {
+        this->ways = ways;
+        this->policy = policy;
+        this->interval = interval;
+        accesses = 0;
+        tenant = 0;
+        occupancy.assign(tenants, 0);
+        quota.assign(tenants, ways / tenants);
+        owners.reset(ways);
+
+        if (policy == CACHESIM_PARTITION_STATIC) {
+            for (unsigned t = 0; t < tenants; t++) quota[t] = staticWays[t];
+        } else if (policy == CACHESIM_PARTITION_UTILITY) {
+            stacks.assign(tenants, std::vector<uint64_t>());
+            hitCounters.assign(tenants, std::vector<size_t>(ways, 0));
+        }
+    }
+
+    // Feeds the utility monitor of the current tenant with one line access.
+    void observe(uint64_t lineTag) {
+        if (policy != CACHESIM_PARTITION_UTILITY) return;
+
+        // Stack-distance update: hit at depth d credits a cache of > d lines
+        std::vector<uint64_t>& stack = stacks[tenant];
+        auto it = std::find(stack.begin(), stack.end(), lineTag);
+        if (it != stack.end()) {
+            hitCounters[tenant][it - stack.begin()]++;
+            std::rotate(stack.begin(), it, it + 1);
+        } else {
+            if (stack.size() == ways) stack.pop_back();
+            stack.insert(stack.begin(), lineTag);
+        }
+
+        if (interval && ++accesses % interval == 0) repartition();
+    }
+
+    // True if the current tenant must replace one of its own lines.
+    bool mustReplaceOwn() const {
+        return active() && occupancy[tenant] > 0 && occupancy[tenant] >= quota[tenant];
+    }
+
+    // True if the current tenant may evict the given resident line.
+    bool replaceable(uint64_t tag) {
+        uint32_t* owner = owners.find(tag);
+        if (!owner) return true;
+        if (mustReplaceOwn()) return *owner == tenant;
+        return occupancy[*owner] > quota[*owner];
+    }
+
+    void claim(uint64_t tag) {
+        if (!active()) return;
+        owners.insert(tag, tenant);
+        occupancy[tenant]++;
+    }
+
+    void release(uint64_t tag) {
+        if (!active()) return;
+        uint32_t* owner = owners.find(tag);
+        if (!owner) return;
+        occupancy[*owner]--;
+        owners.erase(tag);
+    }
+
+    const std::vector<unsigned>& quotas() const { return quota; }
+
+private:
+    int policy;
+    unsigned ways, interval;
+    size_t accesses;
+    std::vector<unsigned> quota, occupancy;
+    FlatTable owners;
+
+    // Utility monitors (UCP only)
+    std::vector<std::vector<uint64_t>> stacks;
+    std::vector<std::vector<size_t>> hitCounters;
+
+    // Lookahead allocation: every tenant keeps one line, the rest go greedily
+    // to whichever tenant gains the most hits per additional line.
+    void repartition() {
+        unsigned tenants = quota.size();
+        std::vector<std::vector<size_t>> utility(tenants, std::vector<size_t>(ways + 1, 0));
+        for (unsigned t = 0; t < tenants; t++) {
+            for (unsigned w = 0; w < ways; w++) {
+                utility[t][w + 1] = utility[t][w] + hitCounters[t][w];
+            }
+            quota[t] = 1;
+        }
+
+        unsigned balance = ways > tenants ? ways - tenants : 0;
+        while (balance > 0) {
+            double bestGain = -1;
+            unsigned winner = 0, winnerLines = 1;
+            for (unsigned t = 0; t < tenants; t++) {
+                for (unsigned k = 1; k <= balance; k++) {
+                    double gain = double(utility[t][quota[t] + k] - utility[t][quota[t]]) / k;
+                    if (gain > bestGain) {
+                        bestGain = gain;
+                        winner = t;
+                        winnerLines = k;
+                    }
+                }
+            }
+            if (bestGain <= 0) {
+                // No tenant benefits any further: spread the remainder evenly
+                for (unsigned t = 0; balance > 0; t = (t + 1) % tenants, balance--) quota[t]++;
+                break;
+            }
+            quota[winner] += winnerLines;
+            balance -= winnerLines;
+        }
+
+        // Age the monitors so the partition follows phase changes
+        for (auto& counters : hitCounters) {
+            for (size_t& c : counters) c /= 2;
+        }
+    }
+};
+
+#endif
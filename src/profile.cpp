@@ -0,0 +1,122 @@
+#include "profile.h"
+
+#ifdef CACHESIM_PROFILE
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <sys/resource.h>
+
+// --- Profiler State ---
+struct PhaseStats {
+    unsigned long long startNs, totalNs;
+    size_t items;
+    size_t allocsAtStart, allocations;
+    bool ran;
+};
+
+static PhaseStats phases[PROFILE_NUM_PHASES];
+static const char* phaseNames[PROFILE_NUM_PHASES] = {
+    "parse", "elaboration", "simulation", "reporting"
+};
+
+static std::atomic<size_t> allocationCount(0);
+
+// Log2 buckets: bucket i holds latencies in [2^(i-1), 2^i) ns, bucket 0 holds 0
+static const int LATENCY_BUCKETS = 64;
+static size_t latencyHistogram[LATENCY_BUCKETS];
+static size_t latencySamples = 0;
+static unsigned long long latencyTotalNs = 0;
+static bool latencyEnabled = false;
+
+// --- Allocation Counting ---
+// Fed by the operator new replacement in profile_alloc.cpp, which is linked
+// into the systemcc binary only; library builds report zero allocations.
+void profile_count_allocation(void) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+// --- Phase Timing ---
+unsigned long long profile_now_ns(void) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void profile_phase_begin(enum ProfilePhase phase) {
+    phases[phase].startNs = profile_now_ns();
+    phases[phase].allocsAtStart = allocationCount.load(std::memory_order_relaxed);
+}
+
+void profile_phase_end(enum ProfilePhase phase, size_t items) {
+    PhaseStats& p = phases[phase];
+    p.totalNs += profile_now_ns() - p.startNs;
+    p.allocations += allocationCount.load(std::memory_order_relaxed) - p.allocsAtStart;
+    p.items += items;
+    p.ran = true;
+}
+
+// --- Request Latency ---
+void profile_enable_latency(void) { latencyEnabled = true; }
+int profile_latency_enabled(void) { return latencyEnabled; }
+
+void profile_record_latency(unsigned long long ns) {
+    int bucket = 0;
+    while (bucket < LATENCY_BUCKETS - 1 && (1ULL << bucket) <= ns) bucket++;
+    latencyHistogram[bucket]++;
+    latencySamples++;
+    latencyTotalNs += ns;
+}
+
+// --- Report ---
+static long peakRssKb() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // Reported in bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+int profile_write_json(const char* path) {
+    FILE* out = std::fopen(path, "w");
+    if (!out) return -1;
+
+    std::fprintf(out, "{\n  \"phases\": {");
+    bool first = true;
+    for (int i = 0; i < PROFILE_NUM_PHASES; i++) {
+        const PhaseStats& p = phases[i];
+        if (!p.ran) continue;
+        double seconds = p.totalNs / 1e9;
+        std::fprintf(out, "%s\n    \"%s\": { \"seconds\": %.9f, \"items\": %zu, "
+                          "\"items_per_second\": %.1f, \"allocations\": %zu }",
+                     first ? "" : ",", phaseNames[i], seconds, p.items,
+                     seconds > 0 ? p.items / seconds : 0.0, p.allocations);
+        first = false;
+    }
+    std::fprintf(out, "\n  },\n");
+    std::fprintf(out, "  \"peak_rss_kb\": %ld,\n", peakRssKb());
+    std::fprintf(out, "  \"simulation_allocations\": %zu", phases[PROFILE_SIMULATION].allocations);
+
+    if (latencyEnabled) {
+        std::fprintf(out, ",\n  \"request_latency_ns\": {\n");
+        std::fprintf(out, "    \"samples\": %zu,\n", latencySamples);
+        std::fprintf(out, "    \"mean\": %.1f,\n",
+                     latencySamples ? (double)latencyTotalNs / latencySamples : 0.0);
+        std::fprintf(out, "    \"buckets\": [");
+        first = true;
+        for (int i = 0; i < LATENCY_BUCKETS; i++) {
+            if (!latencyHistogram[i]) continue;
+            unsigned long long lower = i == 0 ? 0 : 1ULL << (i - 1);
+            unsigned long long upper = i == 0 ? 1 : 1ULL << i;
+            std::fprintf(out, "%s\n      { \"lower\": %llu, \"upper\": %llu, \"count\": %zu }",
+                         first ? "" : ",", lower, upper, latencyHistogram[i]);
+            first = false;
+        }
+        std::fprintf(out, "\n    ]\n  }");
+    }
+    std::fprintf(out, "\n}\n");
+    return std::fclose(out) == 0 ? 0 : -1;
+}
+
+#endif
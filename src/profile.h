@@ -0,0 +1,57 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stddef.h>
+
+// Built-in instrumentation. Compiled in only when CACHESIM_PROFILE is defined
+// (make PROFILE=1); otherwise every macro below expands to nothing.
+
+enum ProfilePhase {
+    PROFILE_PARSE,
+    PROFILE_ELABORATION,
+    PROFILE_SIMULATION,
+    PROFILE_REPORTING,
+    PROFILE_NUM_PHASES
+};
+
+#ifdef CACHESIM_PROFILE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void profile_phase_begin(enum ProfilePhase phase);
+void profile_phase_end(enum ProfilePhase phase, size_t items);
+void profile_enable_latency(void);
+int profile_latency_enabled(void);
+unsigned long long profile_now_ns(void);
+void profile_record_latency(unsigned long long ns);
+void profile_count_allocation(void);
+int profile_write_json(const char* path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define PROFILE_PHASE_BEGIN(phase)      profile_phase_begin(phase)
+#define PROFILE_PHASE_END(phase, items) profile_phase_end(phase, items)
+
+#ifdef __cplusplus
+// Times one simulated request when latency histograms are enabled
+struct ProfileRequestScope {
+    unsigned long long start;
+    ProfileRequestScope() : start(profile_latency_enabled() ? profile_now_ns() : 0) {}
+    ~ProfileRequestScope() { if (start) profile_record_latency(profile_now_ns() - start); }
+};
+#define PROFILE_REQUEST() ProfileRequestScope profileRequestScope
+#endif
+
+#else
+
+#define PROFILE_PHASE_BEGIN(phase)      ((void)0)
+#define PROFILE_PHASE_END(phase, items) ((void)0)
+#define PROFILE_REQUEST()               ((void)0)
+
+#endif
+
+#endif
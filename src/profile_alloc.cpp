@@ -0,0 +1,28 @@
+#include "profile.h"
+
+#ifdef CACHESIM_PROFILE
+
+#include <cstdlib>
+#include <new>
+
+// --- Allocation Counting ---
+// Replaces the global allocation functions process-wide, so this translation
+// unit belongs to the systemcc binary only and is kept out of libcachesim.
+void* operator new(size_t size) {
+    profile_count_allocation();
+    if (size == 0) size = 1;
+    void* p = std::malloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+#endif
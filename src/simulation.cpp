@@ -1,13 +1,15 @@
 #include "simulation.hpp"
+#include "profile.h"
 #include <chrono>
 #include <systemc>
 
-Result run_simulation(int cycles, int directMapped, unsigned cacheLines, 
-                      unsigned cacheLineSize, unsigned cacheLatency, 
-                      unsigned memoryLatency, size_t numRequests, 
-                      struct Request requests[], const char* tracefile) {
+Result run_simulation(int cycles, const struct cachesim_config* config,
+                      size_t numRequests, Request requests[],
+                      const char* tracefile, const char* heatmapFile) {
 
     auto start = std::chrono::high_resolution_clock::now();
+    PROFILE_PHASE_BEGIN(PROFILE_ELABORATION);
+    int directMapped = config->directMapped;
     
     // SystemC Clock and Module Instantiation
     sc_clock clk("clk", 1, SC_NS);
@@ -15,28 +17,46 @@ Result run_simulation(int cycles, int directMapped, unsigned cacheLines,
     DirectMappedCache directMappedCache("directMappedCache");
     FullyAssociativeCache fullyAssociativeCache("fullyAssociativeCache");
 
-    // Initialize Cache Parameters
-    directMappedCache.initialize(cacheLines, cacheLineSize, cacheLatency, memoryLatency);
-    fullyAssociativeCache.initialize(cacheLines, cacheLineSize, cacheLatency, memoryLatency);
+    // Initialize Cache Parameters; the disabled module never sees a request
+    if (directMapped) {
+        directMappedCache.initialize(*config);
+    } else {
+        fullyAssociativeCache.initialize(*config);
+    }
     
     // Setup Simulation Wrapper
     Simulation simulation("sim", directMappedCache, fullyAssociativeCache);
     simulation.clk(clk);
-    simulation.initialize(numRequests, requests, tracefile, directMapped); 
+    simulation.initialize(numRequests, requests, tracefile, directMapped, cycles);
+
+    PROFILE_PHASE_END(PROFILE_ELABORATION, 0);
 
-    // Execute Simulation
-    sc_start(cycles, SC_NS);
+    // Execute Simulation; the feeder stops once the model reaches the cycle limit
+    PROFILE_PHASE_BEGIN(PROFILE_SIMULATION);
+    sc_start();
+    PROFILE_PHASE_END(PROFILE_SIMULATION, directMapped ? simulation.rq1.read() : simulation.rq2.read());
 
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> duration = end - start;
 
     std::cout << "Simulation duration: " << duration.count() << " seconds" << std::endl;
 
-    Result result;
+    // Miss breakdown is kept by the model only; headline counters come from the ports
+    const CacheModel& model = directMapped ? static_cast<const CacheModel&>(directMappedCache.model)
+                                           : static_cast<const CacheModel&>(fullyAssociativeCache.model);
+    Result result = model.stats;
+    bool overLimit = model.stats.cycles > (size_t)cycles;
+
+    // The heatmap export counts as reporting; main() adds the console output
+    PROFILE_PHASE_BEGIN(PROFILE_REPORTING);
+    if (heatmapFile && model.heatmap.active() && writeHeatmap(model.heatmap, heatmapFile) != 0) {
+        std::cerr << "Heatmap Write Error: " << heatmapFile << std::endl;
+    }
+    PROFILE_PHASE_END(PROFILE_REPORTING, 0);
 
     // Direct Mapped Branch
     if (directMapped) {
-        if (simulation.rq1.read() < numRequests) {
+        if (simulation.rq1.read() < numRequests || overLimit) {
             result.cycles = SIZE_MAX;
             result.misses = simulation.misses1.read();
             result.hits   = simulation.hits1.read();
@@ -50,7 +70,7 @@ Result run_simulation(int cycles, int directMapped, unsigned cacheLines,
     } 
     // Fully Associative Branch
     else {
-        if (simulation.rq2.read() < numRequests) {
+        if (simulation.rq2.read() < numRequests || overLimit) {
             result.cycles = SIZE_MAX;
             result.misses = simulation.misses2.read();
             result.hits   = simulation.hits2.read();
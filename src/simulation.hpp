@@ -2,44 +2,21 @@
 #define MODULES_HPP
 
 #include <systemc>
-#include <cmath>
-#include <vector>
-#include <list>
-#include <unordered_map>
 #include <iostream>
+#include "engine.hpp"
 
 using namespace sc_core;
 
 // --- C-Linkage Interface ---
 extern "C" {
-    struct Request {
-        uint32_t addr;
-        uint32_t data;
-        int we; // Write Enable
-    };
-
-    struct Result {
-        size_t cycles;
-        size_t misses;
-        size_t hits;
-        size_t primitiveGateCount;
-    };
-
-    Result run_simulation(int cycles, int directMapped, unsigned cacheLines,
-                          unsigned cacheLineSize, unsigned cacheLatency,
-                          unsigned memoryLatency, size_t numRequests,
-                          Request requests[], const char* tracefile);
-}
+    // Front-end names for the library's request/result types
+    typedef cachesim_request Request;
+    typedef cachesim_result Result;
 
-// --- Data Structures ---
-struct CacheLine {
-    bool valid;
-    uint32_t tag;
-    std::vector<uint8_t> data;
-    
-    CacheLine() : valid(false), tag(0), data() {}
-    CacheLine(unsigned cacheLineSize) : valid(false), tag(0), data(cacheLineSize) {}
-};
+    Result run_simulation(int cycles, const struct cachesim_config* config,
+                          size_t numRequests, Request requests[],
+                          const char* tracefile, const char* heatmapFile);
+}
 
 // --- Direct Mapped Cache Module ---
 SC_MODULE(DirectMappedCache) {
@@ -59,24 +36,15 @@ SC_MODULE(DirectMappedCache) {
     sc_out<size_t> primitiveGateCount;
     sc_out<int> rq;
 
-    std::unordered_map<uint32_t, uint8_t> memory;
-    std::vector<CacheLine> cache;
-    unsigned cacheLines, cacheLineSize, cacheLatency, memoryLatency;
+    DirectMappedModel model;
 
     SC_CTOR(DirectMappedCache) {
         SC_THREAD(exec);
         sensitive << clk.pos();
     }
 
-    void initialize(unsigned cacheLines, unsigned cacheLineSize, unsigned cacheLatency, unsigned memoryLatency) {
-        this->cacheLines = cacheLines;
-        this->cacheLineSize = cacheLineSize;
-        this->cacheLatency = cacheLatency;
-        this->memoryLatency = memoryLatency;
-        cache.resize(cacheLines);
-        for (auto& line : cache) { 
-            line.data.resize(cacheLineSize); 
-        }
+    void initialize(const cachesim_config& config) {
+        model.configure(config);
     }
 
     void exec() {
@@ -85,127 +53,23 @@ SC_MODULE(DirectMappedCache) {
             if (!enable.read()) continue; // Skip if this mode is disabled
 
             rq.write(rq.read() + 1);
-            uint32_t addr = address.read();
+            Request req = { address.read(), Wdata.read(), we.read() };
             uint32_t data;
-            
-            if (we.read() == 1) {
-                // Write Operation
-                data = Wdata.read();
-                writeDataInCache(addr, data);
-                writeDataInMemory(addr, data);
-            } else {
-                // Read Operation
-                bool hit = readDataInCache(addr, data);
-                if (hit) {
-                    Rdata.write(data);
-                    hits.write(hits.read() + 1);
-                } else {
-                    bool inMemory = readDataInMemory(addr, data);
-                    if (inMemory) {
-                        importMemoryBlockToCache(addr, data);
-                        Rdata.write(data);
-                    } else {
-                        std::cerr << "Data fault: Address not in Cache or Memory" << std::endl;
-                        Rdata.write(static_cast<uint32_t>(-1));
-                    }
-                    misses.write(misses.read() + 1);
-                }
-            }
-            cycles.write(cycles.read() + 1);
-        }
-    }
-
-    bool readDataInCache(uint32_t addr, uint32_t &data) {
-        primitiveGateCount.write(primitiveGateCount.read() + 20);
-        unsigned index = (addr / cacheLineSize) % cacheLines;
-        uint32_t offset = addr % cacheLineSize;
-        uint32_t tag = calcTagOfDirectMapped(addr);
 
-        if (cache[index].valid && cache[index].tag == tag) { 
-            data = cache[index].data[offset];
-            primitiveGateCount.write(primitiveGateCount.read() + 10);
-            return true;
-        }
-        return false;
-    }
-
-    void writeDataInCache(uint32_t addr, uint32_t data) {
-        primitiveGateCount.write(primitiveGateCount.read() + 20);
-        unsigned index = (addr / cacheLineSize) % cacheLines;
-        uint32_t tag = calcTagOfDirectMapped(addr);
-        uint32_t offset = addr % cacheLineSize;
-        
-        int entered = 0; 
-        while (data > 0) {
-            if (offset > (cacheLineSize - 1)) {
-                offset = 0;
-                index++;
-                primitiveGateCount.write(primitiveGateCount.read() + 2);
+            if (!model.access(req, data)) {
+                std::cerr << "Data fault: Address not in Cache or Memory" << std::endl;
             }
-            if (index > (cacheLines - 1)) {
-                primitiveGateCount.write(primitiveGateCount.read() + 1);
+            if (req.we == 1 && model.writeTruncated) {
                 std::cout << "Cache Full: Writing truncated." << std::endl;
-                return;
             }
-            entered++;
-            cache[index].valid = true;
-            cache[index].tag = tag;
-            cache[index].data[offset] = data & 255;
-            offset++;
-            data = data >> 8; 
-            primitiveGateCount.write(primitiveGateCount.read() + 10);
-        }
-        if (entered == 0 && data == 0) {
-            cache[index].valid = true;
-            cache[index].tag = tag;
-            cache[index].data[offset] = data;
-            primitiveGateCount.write(primitiveGateCount.read() + 10);
-        }     
-    }
-
-    void importMemoryBlockToCache(uint32_t addr, uint32_t &data) {
-        primitiveGateCount.write(primitiveGateCount.read() + 20);
-        unsigned index = (addr / cacheLineSize) % cacheLines;
-        uint32_t tag = calcTagOfDirectMapped(addr);
-        uint32_t offset = addr % cacheLineSize;
-        uint32_t startAddress = addr - (addr % cacheLineSize);
-
-        for (int i = 0; i < (int)cacheLineSize; i++) {
-            cache[index].data[i] = memory[startAddress + i];
-            primitiveGateCount.write(primitiveGateCount.read() + 10);
-        }
-        cache[index].tag = tag;
-        cache[index].valid = true;
-        data = cache[index].data[offset];
-    }
+            if (req.we != 1) Rdata.write(data);
 
-    bool readDataInMemory(uint32_t addr, uint32_t &data) {
-        if (memory.find(addr) != memory.end()) {
-            data = memory[addr];
-            return true;
+            // Publish statistics once per cycle
+            cycles.write(model.stats.cycles);
+            misses.write(model.stats.misses);
+            hits.write(model.stats.hits);
+            primitiveGateCount.write(model.stats.primitiveGateCount);
         }
-        return false;
-    }
-
-    void writeDataInMemory(uint32_t addr, uint32_t data) {
-        int entered = 0; 
-        while (data > 0) {
-            memory[addr + entered] = data & 255;
-            entered++;
-            data = data >> 8;
-            primitiveGateCount.write(primitiveGateCount.read() + 10);
-        }
-        if (entered == 0 && data == 0) {
-            memory[addr] = data;
-            primitiveGateCount.write(primitiveGateCount.read() + 10);
-        }
-    }
-
-    uint32_t calcTagOfDirectMapped(uint32_t addr) {
-        primitiveGateCount.write(primitiveGateCount.read() + 20);
-        uint32_t offsetBits = std::log2(cacheLineSize);
-        uint32_t indexBits = std::log2(cacheLines);
-        return addr >> (indexBits + offsetBits);
     }
 };
 
@@ -220,24 +84,15 @@ SC_MODULE(FullyAssociativeCache) {
     sc_out<size_t> cycles, misses, hits, primitiveGateCount;
     sc_out<int> rq;
     
-    std::list<uint32_t> tracker_lru;
-    std::unordered_map<uint32_t, std::list<uint32_t>::iterator> map_with_tags;
-    std::unordered_map<uint32_t, uint8_t> memory;
-    std::vector<CacheLine> cache;
-    unsigned cacheLines, cacheLineSize, cacheLatency, memoryLatency;
+    FullyAssociativeModel model;
 
     SC_CTOR(FullyAssociativeCache) {
         SC_THREAD(exec);
         sensitive << clk.pos();
     }
 
-    void initialize(unsigned cacheLines, unsigned cacheLineSize, unsigned cacheLatency, unsigned memoryLatency) {
-        this->cacheLines = cacheLines;
-        this->cacheLineSize = cacheLineSize;
-        this->cacheLatency = cacheLatency;
-        this->memoryLatency = memoryLatency;
-        cache.resize(cacheLines);
-        for (auto& line : cache) { line.data.resize(cacheLineSize); }
+    void initialize(const cachesim_config& config) {
+        model.configure(config);
     }
 
     void exec() {
@@ -246,167 +101,20 @@ SC_MODULE(FullyAssociativeCache) {
             if (!enable.read()) break; 
 
             rq.write(rq.read() + 1);
-            uint32_t addr = address.read();
+            Request req = { address.read(), Wdata.read(), we.read() };
             uint32_t data;
 
-            if (we.read() == 1) {
-                data = Wdata.read();
-                writeDataInCache(addr, data);
-                writeDataInMemory(addr, data);
-            } else {
-                bool hit = readDataInCache(addr, data);
-                if (hit) {
-                    Rdata.write(data);
-                    hits.write(hits.read() + 1);
-                } else {
-                    if (readDataInMemory(addr, data)) {
-                        importMemoryBlockToCache(addr, data);
-                        Rdata.write(data);
-                    } else {
-                        std::cerr << "Data fault: Address not in Cache or Memory" << std::endl;
-                        Rdata.write(static_cast<uint32_t>(-1));
-                    }
-                    misses.write(misses.read() + 1);
-                }
-            }
-            cycles.write(cycles.read() + 1);
-        }
-    }
-
-    bool readDataInCache(uint32_t addr, uint32_t &data) {
-        uint32_t tag = calctagFullAssociative(addr);
-        uint32_t offset = addr % cacheLineSize;
-        for (CacheLine &line : cache) {
-            primitiveGateCount.write(primitiveGateCount.read() + 20);
-            if (line.valid && line.tag == tag) {
-                data = line.data[offset];
-                primitiveGateCount.write(primitiveGateCount.read() + 10);
-                tracker_lru.erase(map_with_tags[tag]); 
-                LRU_first_update(tag);
-                primitiveGateCount.write(primitiveGateCount.read() + 20);
-                return true;
+            if (!model.access(req, data)) {
+                std::cerr << "Data fault: Address not in Cache or Memory" << std::endl;
             }
-        }
-        return false;
-    }
+            if (req.we != 1) Rdata.write(data);
 
-    void writeDataInCache(uint32_t addr, uint32_t data) {
-        primitiveGateCount.write(primitiveGateCount.read() + 2);
-        unsigned numBytes = 0;
-        uint32_t temp = data; 
-        while (temp > 0) { temp >>= 8; numBytes++; }
-        if (numBytes == 0) numBytes = 1;
-
-        while (numBytes > 0) {
-            uint32_t offset = addr % cacheLineSize;
-            uint32_t tag = calctagFullAssociative(addr);
-            
-            if (map_with_tags.find(tag) != map_with_tags.end()) {
-                for (CacheLine &line : cache) {
-                    if (line.valid && line.tag == tag) {
-                        primitiveGateCount.write(primitiveGateCount.read() + 10);
-                        line.data[offset] = data & 255;
-                        tracker_lru.erase(map_with_tags[tag]);
-                        LRU_first_update(tag);    
-                        primitiveGateCount.write(primitiveGateCount.read() + 1);
-                        break;
-                    }
-                }
-            } else if (tracker_lru.size() == cacheLines) {
-                uint32_t tag_to_delete = tracker_lru.back();
-                tracker_lru.pop_back();   
-                map_with_tags.erase(tag_to_delete);   
-                primitiveGateCount.write(primitiveGateCount.read() + 1);
-                for (CacheLine &line : cache) {
-                    if (line.valid && line.tag == tag_to_delete) {
-                        line.tag = tag;
-                        line.data[offset] = data & 255;
-                        primitiveGateCount.write(primitiveGateCount.read() + 10);
-                        LRU_first_update(tag);
-                        primitiveGateCount.write(primitiveGateCount.read() + 2);
-                        break;
-                    }
-                }
-            } else {
-                for (CacheLine &line : cache) {
-                    if (!line.valid) {
-                        line.valid = 1;
-                        line.tag = tag;
-                        line.data[offset] = data & 255;
-                        primitiveGateCount.write(primitiveGateCount.read() + 10);
-                        LRU_first_update(tag);
-                        primitiveGateCount.write(primitiveGateCount.read() + 2);
-                        break;
-                    }
-                }
-            }
-            data >>= 8;
-            numBytes--;
-            addr++;
-            primitiveGateCount.write(primitiveGateCount.read() + 3);
+            cycles.write(model.stats.cycles);
+            misses.write(model.stats.misses);
+            hits.write(model.stats.hits);
+            primitiveGateCount.write(model.stats.primitiveGateCount);
         }
     }
-
-    void importMemoryBlockToCache(uint32_t addr, uint32_t &data) {
-        primitiveGateCount.write(primitiveGateCount.read() + 4);
-        uint32_t startAddress = addr - (addr % cacheLineSize);
-        uint32_t tag = calctagFullAssociative(addr);
-        uint32_t offset = addr % cacheLineSize;
-        uint32_t tag_to_delete = tracker_lru.back();
-        
-        tracker_lru.pop_back();  
-        map_with_tags.erase(tag_to_delete);
-        
-        for (CacheLine &line : cache) {
-            if (line.tag == tag_to_delete) {
-                for (int i = 0; i < (int)cacheLineSize; i++) {
-                    line.data[i] = memory[startAddress + i];
-                    primitiveGateCount.write(primitiveGateCount.read() + 1);
-                }
-                primitiveGateCount.write(primitiveGateCount.read() + 10);
-                line.tag = tag;
-                tracker_lru.push_front(tag);
-                primitiveGateCount.write(primitiveGateCount.read() + 20);
-                map_with_tags[tag] = tracker_lru.begin();
-                line.valid = true;
-                data = line.data[offset];
-            }
-        }
-    }
-        
-    bool readDataInMemory(uint32_t addr, uint32_t &data) {
-        if (memory.find(addr) != memory.end()) {
-            data = memory[addr];
-            return true;
-        }
-        return false;
-    }
-
-    void writeDataInMemory(uint32_t addr, uint32_t data) {
-        int entered = 0;
-        while (data > 0) {
-            memory[addr + entered] = data & 255;
-            entered++;
-            data >>= 8;
-            primitiveGateCount.write(primitiveGateCount.read() + 10);
-        }
-        if (entered == 0 && data == 0) {
-            memory[addr] = data;
-            primitiveGateCount.write(primitiveGateCount.read() + 10);
-        }
-    }
-    
-    void LRU_first_update(uint32_t tag) {
-        tracker_lru.push_front(tag); 
-        primitiveGateCount.write(primitiveGateCount.read() + 20);
-        map_with_tags[tag] = tracker_lru.begin(); 
-    }
-
-    uint32_t calctagFullAssociative(uint32_t addr) {
-        primitiveGateCount.write(primitiveGateCount.read() + 2);
-        uint32_t offsetBits = log2(cacheLineSize);
-        return addr >> offsetBits;
-    }
 };
 
 // --- Top-Level Simulation Wrapper ---
@@ -420,15 +128,22 @@ SC_MODULE(Simulation) {
     sc_signal<size_t> cycles2, misses2, hits2, primitiveGateCount2;
 
     size_t numRequests;
-    struct Request* requests;
+    Request* requests;
     const char* tracefile;
     int directMapped;
+    size_t cycleLimit;
 
     DirectMappedCache& directMappedCache;
     FullyAssociativeCache& fullyAssociativeCache;
 
-    void initialize(size_t n, struct Request r[], const char* tf, int dm) {
-        numRequests = n; requests = r; tracefile = tf; directMapped = dm;
+    void initialize(size_t n, Request r[], const char* tf, int dm, size_t limit) {
+        numRequests = n; requests = r; tracefile = tf; directMapped = dm; cycleLimit = limit;
+    }
+
+    // Model cycles so far; multi-issue and page walks decouple them from clock ticks
+    size_t modelCycles() const {
+        return directMapped ? directMappedCache.model.stats.cycles
+                            : fullyAssociativeCache.model.stats.cycles;
     }
 
     SC_CTOR(Simulation);
@@ -495,7 +210,7 @@ SC_MODULE(Simulation) {
         }
 
         while (true) {
-            if (request_index < numRequests) {
+            if (request_index < numRequests && modelCycles() < cycleLimit) {
                 Request req = requests[request_index];
                 if (directMapped) {
                     address1.write(req.addr); Wdata1.write(req.data); we1.write(req.we);
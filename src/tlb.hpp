@@ -0,0 +1,58 @@
+#ifndef TLB_HPP
+#define TLB_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- Translation Lookaside Buffer ---
+// Set-associative TLB for a single page size with LRU replacement. Entries
+// are kept in flat per-set arrays sized once in initialize(), so lookups
+// only scan one set and never allocate. Entries are tagged with an
+// address-space id (ASID), so tenants never hit each other's translations.
+class Tlb {
+public:
+    Tlb() : ways(0), setMask(0), pageBits(0), clock(0) {}
+
+    bool active() const { return ways > 0; }
+
+    // entries and associativity must be powers of two; associativity 0 makes
+    // the TLB fully associative.
+    void initialize(unsigned entries, unsigned associativity, unsigned pageSize) {
+        ways = (associativity && associativity < entries) ? associativity : entries;
+        setMask = entries / ways - 1;
+        pageBits = std::log2(pageSize);
+        keys.assign(entries, 0);
+        lastUse.assign(entries, 0); // 0 marks an invalid entry
+        clock = 0;
+    }
+
+    // Translates addr; returns false on a miss, after filling the entry.
+    bool lookup(uint32_t asid, uint32_t addr) {
+        uint32_t vpn = addr >> pageBits;
+        uint64_t key = ((uint64_t)asid << 32) | vpn;
+        size_t base = (size_t)(vpn & setMask) * ways;
+        size_t victim = base;
+        clock++;
+        for (size_t i = base; i < base + ways; i++) {
+            if (lastUse[i] && keys[i] == key) {
+                lastUse[i] = clock;
+                return true;
+            }
+            if (lastUse[i] < lastUse[victim]) victim = i;
+        }
+        keys[victim] = key;
+        lastUse[victim] = clock;
+        return false;
+    }
+
+private:
+    unsigned ways, setMask;
+    uint32_t pageBits;
+    uint64_t clock;
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> lastUse;
+};
+
+#endif
@@ -0,0 +1,123 @@
+#include "trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+int parse_request_line(char *line, size_t lineNumber, struct cachesim_request *req,
+                       unsigned long long *timestamp) {
+    char *pos = strpbrk(line, "\r\n");
+    if (pos) *pos = '\0';
+    if (line[0] == '\0') return -1;
+
+    // Split on commas, keeping empty fields (reads leave the data column empty)
+    char *data[4] = { NULL, NULL, NULL, NULL };
+    int data_count = 0;
+    char *field = line;
+    while (field && data_count < 4) {
+        data[data_count++] = field;
+        field = strchr(field, ',');
+        if (field) *field++ = '\0';
+    }
+
+    // Parse Operation (W/R)
+    if (strcmp(data[0], "W") == 0) {
+        req->we = 1;
+    } else if (strcmp(data[0], "R") == 0) {
+        req->we = 0;
+    } else {
+        fprintf(stderr, "Syntax Error: Line %zu has invalid operation '%s'\n", lineNumber, data[0]);
+        return -1;
+    }
+    if (data_count < 2) {
+        fprintf(stderr, "Syntax Error: Line %zu has no address\n", lineNumber);
+        return -1;
+    }
+
+    // Parse Hex Address
+    req->addr = (uint32_t)strtoul(data[1], NULL, 16);
+
+    // Parse Data (only for writes)
+    if (req->we == 1 && data_count >= 3) {
+        req->data = (uint32_t)strtoul(data[2], NULL, 10);
+    } else {
+        req->data = 0;
+    }
+
+    // Parse Timestamp (optional)
+    if (timestamp) {
+        *timestamp = (data_count == 4 && data[3][0] != '\0')
+                   ? strtoull(data[3], NULL, 10) : lineNumber;
+    }
+    return 0;
+}
+
+int trace_open(struct TraceStream *stream, const char *filename) {
+    stream->file = fopen(filename, "r");
+    stream->line = 0;
+    stream->valid = 0;
+    if (!stream->file) {
+        perror("File Open Error");
+        return -1;
+    }
+    trace_advance(stream);
+    return 0;
+}
+
+void trace_advance(struct TraceStream *stream) {
+    char line[1024];
+    stream->valid = 0;
+    while (stream->file && fgets(line, sizeof(line), stream->file)) {
+        stream->line++;
+        if (parse_request_line(line, stream->line, &stream->next, &stream->timestamp) == 0) {
+            stream->valid = 1;
+            return;
+        }
+    }
+}
+
+void trace_close(struct TraceStream *stream) {
+    if (stream->file) fclose(stream->file);
+    stream->file = NULL;
+    stream->valid = 0;
+}
+
+void merge_init(struct TraceMerge *merge, struct TraceStream *streams, unsigned count,
+                int policy, const unsigned *weights) {
+    merge->streams = streams;
+    merge->count = count;
+    merge->policy = policy;
+    merge->weights = (policy == INTERLEAVE_WEIGHTED) ? weights : NULL;
+    merge->current = 0;
+    merge->issued = 0;
+}
+
+int merge_next(struct TraceMerge *merge, unsigned *tenant, struct cachesim_request *req) {
+    unsigned pick = merge->count;
+
+    if (merge->policy == INTERLEAVE_TIMESTAMP) {
+        // Earliest pending timestamp wins; ties go to the lower trace index
+        for (unsigned i = 0; i < merge->count; i++) {
+            struct TraceStream *s = &merge->streams[i];
+            if (s->valid && (pick == merge->count || s->timestamp < merge->streams[pick].timestamp)) {
+                pick = i;
+            }
+        }
+    } else {
+        // Stay on the current trace until its turn is used up or it runs dry
+        for (unsigned tries = 0; tries <= merge->count; tries++) {
+            unsigned weight = merge->weights ? merge->weights[merge->current] : 1;
+            if (merge->streams[merge->current].valid && merge->issued < weight) {
+                pick = merge->current;
+                merge->issued++;
+                break;
+            }
+            merge->current = (merge->current + 1) % merge->count;
+            merge->issued = 0;
+        }
+    }
+
+    if (pick == merge->count) return 0;
+    *tenant = pick;
+    *req = merge->streams[pick].next;
+    trace_advance(&merge->streams[pick]);
+    return 1;
+}
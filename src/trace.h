@@ -0,0 +1,53 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include "cachesim.h"
+
+// --- CSV Trace Parsing ---
+// Line format: [Operation (W/R)], [Hex Address], [Data (Decimal)], [Timestamp]
+// Data is only read for writes; the optional timestamp defaults to the line
+// number and is used only by timestamp-merged interleaving.
+
+// Returns 0 on success, -1 if the line is blank or malformed.
+int parse_request_line(char *line, size_t lineNumber, struct cachesim_request *req,
+                       unsigned long long *timestamp);
+
+// --- Streaming Reader ---
+// Holds one look-ahead request so several traces can be merged without
+// loading any of them into memory.
+struct TraceStream {
+    FILE *file;
+    size_t line;
+    int valid; // next/timestamp hold an unconsumed request
+    struct cachesim_request next;
+    unsigned long long timestamp;
+};
+
+int trace_open(struct TraceStream *stream, const char *filename);
+void trace_advance(struct TraceStream *stream);
+void trace_close(struct TraceStream *stream);
+
+// --- Multi-Trace Interleaving ---
+enum InterleavePolicy {
+    INTERLEAVE_ROUND_ROBIN, // One request per trace in turn
+    INTERLEAVE_WEIGHTED,    // weights[i] consecutive requests from trace i per turn
+    INTERLEAVE_TIMESTAMP    // Globally ordered by timestamp
+};
+
+struct TraceMerge {
+    struct TraceStream *streams;
+    unsigned count;
+    int policy;
+    const unsigned *weights; // NULL means weight 1 for every trace
+    unsigned current, issued;
+};
+
+void merge_init(struct TraceMerge *merge, struct TraceStream *streams, unsigned count,
+                int policy, const unsigned *weights);
+
+// Produces the next request and the index of the trace it came from.
+// Returns 0 once every trace is exhausted.
+int merge_next(struct TraceMerge *merge, unsigned *tenant, struct cachesim_request *req);
+
+#endif
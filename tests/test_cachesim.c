@@ -0,0 +1,251 @@
+// Kernel-free regression tests for the cachesim library (make check).
+#include "cachesim.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static int failures = 0;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+// --- Helpers ---
+static struct cachesim_config base_config(void) {
+    struct cachesim_config config;
+    memset(&config, 0, sizeof(config));
+    config.cacheLines = 16;
+    config.cacheLineSize = 16;
+    config.cacheLatency = 1;
+    config.memoryLatency = 10;
+    return config;
+}
+
+static struct cachesim_request make_request(uint32_t addr, int we) {
+    struct cachesim_request req;
+    req.addr = addr;
+    req.data = addr ^ 0x5a5a5a5a;
+    req.we = we;
+    return req;
+}
+
+static int same_result(const struct cachesim_result* a, const struct cachesim_result* b) {
+    return a->cycles == b->cycles && a->misses == b->misses && a->hits == b->hits &&
+           a->primitiveGateCount == b->primitiveGateCount &&
+           a->compulsoryMisses == b->compulsoryMisses && a->capacityMisses == b->capacityMisses &&
+           a->conflictMisses == b->conflictMisses && a->requests == b->requests &&
+           a->bankConflicts == b->bankConflicts && a->tlbHits == b->tlbHits &&
+           a->tlbMisses == b->tlbMisses;
+}
+
+// Writes every line of [0, lines * 16) once, then reads the region n times.
+static size_t sweep_trace(struct cachesim_request* trace, unsigned lines, unsigned n) {
+    size_t count = 0;
+    for (unsigned i = 0; i < lines; i++) trace[count++] = make_request(i * 16, 1);
+    for (unsigned r = 0; r < n; r++) {
+        for (unsigned i = 0; i < lines; i++) trace[count++] = make_request(i * 16, 0);
+    }
+    return count;
+}
+
+// --- Tests ---
+static void test_instance_reuse(void) {
+    struct cachesim_request trace[1024];
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < 1024; i++) {
+        seed = seed * 1103515245u + 12345u;
+        trace[i] = make_request((seed >> 8) & 0x3ff, i < 256 || (seed & 1));
+    }
+
+    struct cachesim_config config = base_config();
+    config.classifyMisses = 1;
+
+    for (int directMapped = 0; directMapped <= 1; directMapped++) {
+        config.directMapped = directMapped;
+
+        // One batch
+        cachesim* sim = cachesim_create(&config);
+        CHECK(sim != NULL);
+        if (!sim) return;
+        struct cachesim_result whole;
+        CHECK(cachesim_access_batch(sim, trace, 1024, &whole) == 1024);
+        struct cachesim_result total = cachesim_stats(sim);
+        CHECK(same_result(&whole, &total));
+        CHECK(whole.requests == 1024);
+        CHECK(whole.hits + whole.misses > 0);
+        cachesim_destroy(sim);
+
+        // Two batches on a fresh instance match the single batch
+        sim = cachesim_create(&config);
+        CHECK(sim != NULL);
+        if (!sim) return;
+        struct cachesim_result first, second;
+        CHECK(cachesim_access_batch(sim, trace, 300, &first) == 300);
+        CHECK(cachesim_access_batch(sim, trace + 300, 724, &second) == 724);
+        total = cachesim_stats(sim);
+        CHECK(same_result(&whole, &total));
+        CHECK(first.misses + second.misses == whole.misses);
+        CHECK(first.cycles + second.cycles == whole.cycles);
+        cachesim_destroy(sim);
+    }
+}
+
+static void test_fully_associative_has_no_conflict_misses(void) {
+    struct cachesim_request trace[32 + 4 * 32];
+    size_t n = sweep_trace(trace, 32, 4);
+
+    struct cachesim_config config = base_config();
+    config.classifyMisses = 1;
+    cachesim* sim = cachesim_create(&config);
+    CHECK(sim != NULL);
+    if (!sim) return;
+    struct cachesim_result result;
+    cachesim_access_batch(sim, trace, n, &result);
+    CHECK(result.conflictMisses == 0);
+    CHECK(result.capacityMisses > 0);
+    CHECK(result.compulsoryMisses + result.capacityMisses + result.conflictMisses == result.misses);
+    cachesim_destroy(sim);
+
+    // Two lines that share a direct-mapped set thrash it despite free capacity
+    struct cachesim_request pingpong[2 + 2 * 8];
+    n = 0;
+    pingpong[n++] = make_request(0, 1);
+    pingpong[n++] = make_request(16 * 16, 1);
+    for (int r = 0; r < 8; r++) {
+        pingpong[n++] = make_request(0, 0);
+        pingpong[n++] = make_request(16 * 16, 0);
+    }
+    config.directMapped = 1;
+    sim = cachesim_create(&config);
+    CHECK(sim != NULL);
+    if (!sim) return;
+    cachesim_access_batch(sim, pingpong, n, &result);
+    CHECK(result.conflictMisses == 16);
+    CHECK(result.compulsoryMisses + result.capacityMisses + result.conflictMisses == result.misses);
+    cachesim_destroy(sim);
+}
+
+static void test_static_partition_isolation(void) {
+    const unsigned ways[2] = { 4, 12 };
+    struct cachesim_config config = base_config();
+    config.numTenants = 2;
+    config.partitionPolicy = CACHESIM_PARTITION_STATIC;
+    config.tenantWays = ways;
+    cachesim* sim = cachesim_create(&config);
+    CHECK(sim != NULL);
+    if (!sim) return;
+
+    // Tenant 0 keeps four lines hot while tenant 1 streams through 64 lines
+    struct cachesim_request hot[4], stream[64];
+    for (unsigned i = 0; i < 4; i++) hot[i] = make_request(i * 16, 1);
+    for (unsigned i = 0; i < 64; i++) stream[i] = make_request(0x10000 + i * 16, 1);
+    cachesim_access_tenant_batch(sim, 0, hot, 4, NULL);
+    for (unsigned i = 0; i < 4; i++) hot[i].we = 0;
+    for (int r = 0; r < 8; r++) {
+        cachesim_access_tenant_batch(sim, 1, stream, 64, NULL);
+        cachesim_access_tenant_batch(sim, 0, hot, 4, NULL);
+    }
+
+    struct cachesim_result tenant0 = cachesim_tenant_stats(sim, 0);
+    CHECK(tenant0.hits == 32);
+    CHECK(tenant0.misses == 0);
+    cachesim_destroy(sim);
+
+    // Without sharedAddressSpace tenants never see each other's lines
+    struct cachesim_request write = make_request(0x40, 1), read = make_request(0x40, 0);
+    struct cachesim_result result;
+    config = base_config();
+    config.numTenants = 2;
+    for (int shared = 0; shared <= 1; shared++) {
+        config.sharedAddressSpace = shared;
+        sim = cachesim_create(&config);
+        CHECK(sim != NULL);
+        if (!sim) return;
+        cachesim_access_tenant_batch(sim, 0, &write, 1, NULL);
+        cachesim_access_tenant_batch(sim, 1, &read, 1, &result);
+        CHECK(result.hits == (size_t)shared);
+        CHECK(result.misses == (size_t)!shared);
+        cachesim_destroy(sim);
+    }
+}
+
+static void test_bank_conflicts(void) {
+    struct cachesim_config config = base_config();
+    config.issueWidth = 4;
+    config.numBanks = 4;
+    struct cachesim_request trace[16];
+    struct cachesim_result result;
+
+    // Consecutive lines map to distinct banks: four requests per cycle
+    for (unsigned i = 0; i < 16; i++) trace[i] = make_request((i % 4) * 16, 1);
+    cachesim* sim = cachesim_create(&config);
+    CHECK(sim != NULL);
+    if (!sim) return;
+    cachesim_access_batch(sim, trace, 16, &result);
+    CHECK(result.requests == 16);
+    CHECK(result.cycles == 4);
+    CHECK(result.bankConflicts == 0);
+    cachesim_destroy(sim);
+
+    // Lines four apart share a bank: every request after the first stalls
+    for (unsigned i = 0; i < 8; i++) trace[i] = make_request(i * 4 * 16, 1);
+    sim = cachesim_create(&config);
+    CHECK(sim != NULL);
+    if (!sim) return;
+    cachesim_access_batch(sim, trace, 8, &result);
+    CHECK(result.cycles == 8);
+    CHECK(result.bankConflicts == 7);
+    cachesim_destroy(sim);
+}
+
+static void test_tlb(void) {
+    struct cachesim_config config = base_config();
+    config.tlbEntries = 4;
+    config.pageSize = 4096;
+    config.pageWalkLatency = 100;
+    struct cachesim_request trace[10];
+    struct cachesim_result result;
+
+    // Four pages fit: the second pass hits
+    for (unsigned i = 0; i < 8; i++) trace[i] = make_request((i % 4) * 4096, 1);
+    cachesim* sim = cachesim_create(&config);
+    CHECK(sim != NULL);
+    if (!sim) return;
+    cachesim_access_batch(sim, trace, 8, &result);
+    CHECK(result.tlbMisses == 4);
+    CHECK(result.tlbHits == 4);
+    CHECK(result.cycles == 8 + 4 * 100);
+    cachesim_destroy(sim);
+
+    // Five pages cycled through four LRU entries always miss
+    for (unsigned i = 0; i < 10; i++) trace[i] = make_request((i % 5) * 4096, 1);
+    sim = cachesim_create(&config);
+    CHECK(sim != NULL);
+    if (!sim) return;
+    cachesim_access_batch(sim, trace, 10, &result);
+    CHECK(result.tlbMisses == 10);
+    CHECK(result.tlbHits == 0);
+    cachesim_destroy(sim);
+
+    // Associativity above the entry count is rejected
+    config.tlbAssociativity = 8;
+    CHECK(cachesim_create(&config) == NULL);
+}
+
+int main(void) {
+    test_instance_reuse();
+    test_fully_associative_has_no_conflict_misses();
+    test_static_partition_isolation();
+    test_bank_conflicts();
+    test_tlb();
+
+    if (failures) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("All cachesim tests passed\n");
+    return 0;
+}